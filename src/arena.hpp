@@ -0,0 +1,163 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// Arena (bump allocator) para a memória temporária de um lote.
+// Alocar é só avançar um ponteiro dentro do bloco atual; desalocar não faz nada. Tudo é
+// liberado de uma vez com reset(), que mantém os blocos para o próximo lote. Implementa
+// std::pmr::memory_resource, então qualquer contêiner std::pmr pode alocar nela.
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultBlockSize = 1 << 20;
+
+    explicit Arena(size_t blockSize = kDefaultBlockSize) : blockSize_(blockSize) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // descarta tudo o que foi alocado, mantendo os blocos já reservados
+    void reset() {
+        current_ = 0;
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    // bytes entregues desde o último reset e bytes reservados no total
+    size_t bytesUsed() const { return used_; }
+    size_t capacity() const {
+        size_t total = 0;
+        for (const auto& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        while (current_ < blocks_.size()) {
+            Block& block = blocks_[current_];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            uintptr_t aligned = (base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            if (aligned + bytes <= base + block.size) {
+                offset_ = static_cast<size_t>(aligned - base) + bytes;
+                used_ += bytes;
+                return reinterpret_cast<void*>(aligned);
+            }
+            // não coube: segue para o próximo bloco (reaproveitado de lotes anteriores)
+            ++current_;
+            offset_ = 0;
+        }
+
+        Block block;
+        block.size = std::max(blockSize_, bytes + alignment);
+        block.data.reset(new char[block.size]);
+        blocks_.push_back(std::move(block));
+        return do_allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+    };
+
+    size_t blockSize_;
+    std::vector<Block> blocks_;
+    size_t current_ = 0;  // bloco em uso
+    size_t offset_ = 0;   // próximo byte livre no bloco em uso
+    size_t used_ = 0;
+};
+
+// Conjunto de arenas reaproveitadas entre lotes. acquire() entrega uma arena vazia; quando
+// o Lease sai de escopo ela é zerada (reset) e volta para o pool, sem devolver memória ao SO.
+class ArenaPool {
+public:
+    class Lease {
+    public:
+        Lease(ArenaPool& pool, std::unique_ptr<Arena> arena) : pool_(&pool), arena_(std::move(arena)) {}
+        Lease(Lease&&) = default;
+        Lease& operator=(Lease&&) = default;
+
+        ~Lease() {
+            if (arena_) {
+                pool_->release(std::move(arena_));
+            }
+        }
+
+        Arena& operator*() const { return *arena_; }
+        Arena* operator->() const { return arena_.get(); }
+
+    private:
+        ArenaPool* pool_;
+        std::unique_ptr<Arena> arena_;
+    };
+
+    explicit ArenaPool(size_t blockSize = Arena::kDefaultBlockSize) : blockSize_(blockSize) {}
+
+    Lease acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            return Lease(*this, std::make_unique<Arena>(blockSize_));
+        }
+        std::unique_ptr<Arena> arena = std::move(free_.back());
+        free_.pop_back();
+        return Lease(*this, std::move(arena));
+    }
+
+    size_t available() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_.size();
+    }
+
+private:
+    void release(std::unique_ptr<Arena> arena) {
+        arena->reset();
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(arena));
+    }
+
+    size_t blockSize_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Arena>> free_;
+};
+
+// arena do lote que a thread atual está processando (nullptr fora de um ArenaScope)
+inline Arena*& currentArena() {
+    static thread_local Arena* arena = nullptr;
+    return arena;
+}
+
+// recurso para estruturas temporárias: a arena do lote, ou o heap comum se não houver uma
+inline std::pmr::memory_resource* batchResource() {
+    Arena* arena = currentArena();
+    return arena ? static_cast<std::pmr::memory_resource*>(arena) : std::pmr::new_delete_resource();
+}
+
+// Torna uma arena a arena do lote corrente da thread enquanto o escopo existir
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) : previous_(currentArena()) {
+        currentArena() = &arena;
+    }
+
+    ~ArenaScope() {
+        currentArena() = previous_;
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena* previous_;
+};
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+// Máscara de linhas compactada em palavras de 64 bits (bit i = linha i selecionada).
+// AND/OR/NOT e contagem operam palavra a palavra; os bits além de size() ficam sempre zerados.
+class Bitmap {
+public:
+    Bitmap() {}
+
+    explicit Bitmap(size_t size, bool value = false)
+        : size_(size), words_((size + 63) / 64, value ? ~uint64_t(0) : 0) {
+        clearTail();
+    }
+
+    // compacta uma máscara de um byte por linha (0 ou 1)
+    static Bitmap fromBytes(const uint8_t* bytes, size_t size) {
+        Bitmap result(size);
+        result.assignBytes(0, bytes, size);
+        return result;
+    }
+
+    // sobrescreve as linhas [begin, begin + n) a partir de bytes 0/1; begin deve ser múltiplo de 64
+    void assignBytes(size_t begin, const uint8_t* bytes, size_t n) {
+        if (begin % 64 != 0 || begin + n > size_) {
+            throw std::invalid_argument("Bitmap::assignBytes needs a word-aligned range inside the bitmap.");
+        }
+        uint64_t* out = &words_[begin / 64];
+        size_t full = n / 64;
+        for (size_t w = 0; w < full; ++w) {
+            out[w] = packWord(bytes + w * 64, 64);
+        }
+        if (n % 64) {
+            out[full] = packWord(bytes + full * 64, n % 64);
+        }
+    }
+
+    size_t size() const { return size_; }
+    size_t numWords() const { return words_.size(); }
+    const uint64_t* words() const { return words_.data(); }
+    uint64_t* words() { return words_.data(); }
+
+    bool test(size_t i) const {
+        return (words_[i >> 6] >> (i & 63)) & 1;
+    }
+
+    void set(size_t i) {
+        words_[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+
+    void reset(size_t i) {
+        words_[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    }
+
+    // crescimento no fim (bitmaps de validade acompanham o tamanho da coluna)
+    void push_back(bool value) {
+        if (size_ % 64 == 0) {
+            words_.push_back(0);
+        }
+        if (value) {
+            words_[size_ >> 6] |= uint64_t(1) << (size_ & 63);
+        }
+        ++size_;
+    }
+
+    void pop_back() {
+        if (size_ == 0) {
+            throw std::out_of_range("No bits to remove.");
+        }
+        --size_;
+        if (size_ % 64 == 0) {
+            words_.pop_back();
+        } else {
+            clearTail();
+        }
+    }
+
+    // acrescenta os bits de other no fim (palavra a palavra quando alinhado)
+    void append(const Bitmap& other) {
+        if (size_ % 64 == 0) {
+            words_.insert(words_.end(), other.words_.begin(), other.words_.end());
+            size_ += other.size_;
+            return;
+        }
+        for (size_t i = 0; i < other.size_; ++i) {
+            push_back(other.test(i));
+        }
+    }
+
+    // remove o bit i, deslocando os seguintes uma posição para trás
+    void erase(size_t i) {
+        for (size_t j = i; j + 1 < size_; ++j) {
+            if (test(j + 1)) set(j); else reset(j);
+        }
+        pop_back();
+    }
+
+    // cópia dos bits em [begin, end)
+    Bitmap slice(size_t begin, size_t end) const {
+        Bitmap result(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            if (test(i)) result.set(i - begin);
+        }
+        return result;
+    }
+
+    // bits nas posições selecionadas por mask, compactados (como gather() para valores)
+    Bitmap gather(const Bitmap& mask) const {
+        Bitmap result;
+        mask.forEachSet([&](size_t i) { result.push_back(test(i)); });
+        return result;
+    }
+
+    // número de linhas selecionadas
+    size_t count() const {
+        size_t total = 0;
+        for (uint64_t word : words_) {
+            total += static_cast<size_t>(__builtin_popcountll(word));
+        }
+        return total;
+    }
+
+    Bitmap& operator&=(const Bitmap& other) {
+        checkSize(other);
+        for (size_t w = 0; w < words_.size(); ++w) words_[w] &= other.words_[w];
+        return *this;
+    }
+
+    Bitmap& operator|=(const Bitmap& other) {
+        checkSize(other);
+        for (size_t w = 0; w < words_.size(); ++w) words_[w] |= other.words_[w];
+        return *this;
+    }
+
+    Bitmap operator&(const Bitmap& other) const { Bitmap result(*this); return result &= other; }
+    Bitmap operator|(const Bitmap& other) const { Bitmap result(*this); return result |= other; }
+
+    Bitmap operator~() const {
+        Bitmap result(*this);
+        for (uint64_t& word : result.words_) word = ~word;
+        result.clearTail();
+        return result;
+    }
+
+    // chama f(i) para cada linha selecionada, em ordem crescente
+    template <typename F>
+    void forEachSet(F&& f) const {
+        for (size_t w = 0; w < words_.size(); ++w) {
+            uint64_t word = words_[w];
+            while (word) {
+                f(w * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    static uint64_t packWord(const uint8_t* bytes, size_t n) {
+        uint64_t word = 0;
+        for (size_t i = 0; i < n; ++i) {
+            word |= uint64_t(bytes[i] & 1) << i;
+        }
+        return word;
+    }
+
+    void checkSize(const Bitmap& other) const {
+        if (other.size_ != size_) {
+            throw std::invalid_argument("Bitmaps must have the same size.");
+        }
+    }
+
+    void clearTail() {
+        if (size_ % 64 && !words_.empty()) {
+            words_.back() &= (uint64_t(1) << (size_ % 64)) - 1;
+        }
+    }
+
+    size_t size_ = 0;
+    std::vector<uint64_t> words_;
+};
+
+// Compacta as posições selecionadas de values em um novo vetor (uma passada por coluna).
+// Palavras cheias são copiadas em bloco; as demais seguem os bits setados.
+template <typename T>
+std::vector<T> gather(const std::vector<T>& values, const Bitmap& mask) {
+    std::vector<T> result;
+    result.reserve(mask.count());
+    const uint64_t* words = mask.words();
+    for (size_t w = 0; w < mask.numWords(); ++w) {
+        uint64_t word = words[w];
+        size_t base = w * 64;
+        if (word == ~uint64_t(0)) {
+            result.insert(result.end(), values.begin() + base, values.begin() + base + 64);
+            continue;
+        }
+        while (word) {
+            result.push_back(values[base + static_cast<size_t>(__builtin_ctzll(word))]);
+            word &= word - 1;
+        }
+    }
+    return result;
+}
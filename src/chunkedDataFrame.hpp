@@ -0,0 +1,78 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "dataframe.hpp"
+
+// DataFrame em lotes (record batches) para consumo FIFO: os lotes ficam em uma fila e
+// head_ marca quantas linhas do primeiro lote já foram consumidas. Acrescentar no fim só
+// move o lote para a fila; retirar da frente move lotes inteiros ou copia apenas as linhas
+// retiradas de um lote parcial. As duas operações são O(1) amortizado por linha.
+template <typename T>
+class ChunkedDataFrame {
+public:
+    void append(DataFrame<T>&& batch) {
+        if (batch.numRows() == 0) {
+            return;
+        }
+        checkColumns(batch);
+        rows_ += batch.numRows();
+        batches_.push_back(std::move(batch));
+    }
+
+    void append(const DataFrame<T>& batch) {
+        append(batch.copy());
+    }
+
+    size_t numRows() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+    size_t numBatches() const { return batches_.size(); }
+    const std::vector<std::string>& getColumns() const { return columns_; }
+
+    // retira as n primeiras linhas (todas, se houver menos)
+    DataFrame<T> popFront(size_t n) {
+        DataFrame<T> result;
+        while (n > 0 && !batches_.empty()) {
+            DataFrame<T>& front = batches_.front();
+            size_t available = static_cast<size_t>(front.numRows()) - head_;
+            size_t take = std::min(n, available);
+
+            if (head_ == 0 && take == available) {
+                // lote inteiro: sai da fila sem copiar nada
+                result.append(std::move(front));
+                batches_.pop_front();
+            } else {
+                result.append(front.extractLines(head_, head_ + take));
+                head_ += take;
+                if (take == available) {
+                    batches_.pop_front();
+                    head_ = 0;
+                }
+            }
+            n -= take;
+            rows_ -= take;
+        }
+        return result;
+    }
+
+    // todas as linhas restantes em um único DataFrame (a fila fica vazia)
+    DataFrame<T> toDataFrame() {
+        return popFront(rows_);
+    }
+
+private:
+    void checkColumns(const DataFrame<T>& batch) {
+        if (columns_.empty()) {
+            columns_ = batch.getColumns();
+        } else if (batch.getColumns() != columns_) {
+            throw std::invalid_argument("DataFrames must have the same columns to concatenate.");
+        }
+    }
+
+    std::deque<DataFrame<T>> batches_;
+    size_t head_ = 0;   // linhas já consumidas do primeiro lote
+    size_t rows_ = 0;   // linhas ainda disponíveis
+    std::vector<std::string> columns_;
+};
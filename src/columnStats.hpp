@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+#include <type_traits>
+#include "series.hpp"
+
+// inteiro na forma canônica ("-12", "0", "345"; sem '+', espaços ou zeros à esquerda), para
+// que texto -> inteiro -> texto devolva o mesmo texto
+inline bool parseCanonicalInt(std::string_view text, int64_t& out) {
+    size_t i = 0;
+    bool negative = !text.empty() && text[0] == '-';
+    if (negative) i = 1;
+    size_t digits = text.size() - i;
+    if (digits == 0 || digits > 18 || (text[i] == '0' && (digits > 1 || negative))) {
+        return false;
+    }
+    int64_t value = 0;
+    for (; i < text.size(); ++i) {
+        char c = text[i];
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + (c - '0');
+    }
+    out = negative ? -value : value;
+    return true;
+}
+
+// Estatísticas baratas de uma coluna, usadas para escolher a estratégia de agregação:
+// nulos, estimativa de valores distintos (NDV) e, para colunas inteiras, min/max e densidade.
+// Como os zone maps, ficam em cache no DataFrame e valem enquanto a série não muda.
+template <typename T>
+class ColumnStats {
+public:
+    static constexpr size_t kSampleRows = 2048;
+
+    ColumnStats() {}
+
+    explicit ColumnStats(const Series<T>& series)
+        : rows_(series.size()), data_(series.values().data()), version_(series.version()) {
+        const std::vector<T>& values = series.values();
+        nullCount_ = series.nullCount();
+
+        // uma passada: os valores são todos inteiros? (e, se forem, min/max)
+        integer_ = rows_ > nullCount_;
+        bool first = true;
+        for (size_t i = 0; i < rows_ && integer_; ++i) {
+            if (series.isNull(i)) continue;
+            int64_t value;
+            if (!toInteger(values[i], value)) {
+                integer_ = false;
+                break;
+            }
+            min_ = first ? value : std::min(min_, value);
+            max_ = first ? value : std::max(max_, value);
+            first = false;
+        }
+
+        distinct_ = estimateDistinct(series);
+    }
+
+    // a estatística continua válida enquanto a série não muda (mesmo buffer, tamanho e versão)
+    bool isFresh(const Series<T>& series) const {
+        return series.values().data() == data_ && series.size() == rows_ && series.version() == version_;
+    }
+
+    size_t rows() const { return rows_; }
+    size_t nullCount() const { return nullCount_; }
+    size_t distinctEstimate() const { return distinct_; }
+
+    bool isInteger() const { return integer_; }
+    int64_t min() const { return min_; }
+    int64_t max() const { return max_; }
+
+    // quantidade de inteiros em [min, max] (0 se a coluna não é inteira)
+    uint64_t integerRange() const {
+        return integer_ ? static_cast<uint64_t>(max_ - min_) + 1 : 0;
+    }
+
+    // fração da faixa [min, max] ocupada por valores distintos
+    double integerDensity() const {
+        return integer_ ? std::min(1.0, static_cast<double>(distinct_) / static_cast<double>(integerRange())) : 0.0;
+    }
+
+private:
+    static bool toInteger(const T& value, int64_t& out) {
+        if constexpr (std::is_integral<T>::value) {
+            out = static_cast<int64_t>(value);
+            return true;
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            return parseCanonicalInt(value, out);
+        } else {
+            return false;
+        }
+    }
+
+    // NDV por amostragem: até kSampleRows linhas espaçadas uniformemente. Com a coluna inteira
+    // na amostra a contagem é exata; senão usa o estimador GEE (sqrt(N/n) * f1 + demais), onde
+    // f1 é o número de valores vistos uma única vez na amostra. Se quase tudo na amostra é
+    // único (GEE subestima muito nesse caso), a coluna é tratada como quase-chave: d * N / n.
+    static size_t estimateDistinct(const Series<T>& series) {
+        const std::vector<T>& values = series.values();
+        const size_t rows = values.size();
+        if (rows == 0) return 0;
+
+        const size_t step = std::max<size_t>(1, rows / kSampleRows);
+        using Key = typename std::conditional<std::is_same<T, std::string>::value, std::string_view, T>::type;
+        std::unordered_map<Key, size_t> frequency;
+        size_t sampled = 0;
+        for (size_t i = 0; i < rows; i += step) {
+            if (series.isNull(i)) continue;
+            ++frequency[Key(values[i])];
+            ++sampled;
+        }
+        if (step == 1 || sampled == 0) {
+            return frequency.size();
+        }
+
+        size_t singletons = 0;
+        for (const auto& entry : frequency) {
+            if (entry.second == 1) ++singletons;
+        }
+        double population = static_cast<double>(rows - series.nullCount());
+        if (singletons * 10 >= sampled * 9) {
+            return static_cast<size_t>(population * frequency.size() / sampled);
+        }
+        double scale = std::sqrt(population / static_cast<double>(sampled));
+        return static_cast<size_t>(scale * singletons) + (frequency.size() - singletons);
+    }
+
+    size_t rows_ = 0;
+    const T* data_ = nullptr;
+    uint64_t version_ = 0;
+    size_t nullCount_ = 0;
+    size_t distinct_ = 0;
+    bool integer_ = false;
+    int64_t min_ = 0;
+    int64_t max_ = 0;
+};
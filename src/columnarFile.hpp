@@ -0,0 +1,732 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <unordered_map>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include "dataframe.hpp"
+#include "mappedFile.hpp"
+#include "predicate.hpp"
+#include "stringColumn.hpp"
+
+// Formato colunar nativo do framework (.cecol)
+//
+//   "CECOL002" | chunks de colunas (alinhados a 8 bytes) | rodapé | u64 offset do rodapé | "CECOL002"
+//
+// Cada chunk guarda até chunkRows linhas de uma coluna já tipada (int64, float64 ou string).
+// Strings usam página de dicionário quando o chunk tem poucos valores distintos. O rodapé
+// indexa offset, codificação, estatísticas min/max e página de validade de cada chunk. Tudo
+// em little-endian. Arquivos "CECOL001" (sem páginas de validade) continuam legíveis.
+//
+// Layout dos chunks:
+//   Int64/Float64 plain : valores[rows]
+//   String plain        : u32 offsets[rows + 1] | bytes
+//   String dictionary   : u32 dictSize | u32 offsets[dictSize + 1] | bytes | pad 4 | u32 codes[rows]
+//   + validade (só em chunks com nulos): pad 8 | u64 palavras[(rows + 63) / 64], bit 1 = presente
+namespace columnar {
+
+enum class ColumnType : uint8_t { Int64 = 0, Float64 = 1, String = 2 };
+enum class Encoding : uint8_t { Plain = 0, Dictionary = 1 };
+
+static constexpr char kMagic[8] = {'C', 'E', 'C', 'O', 'L', '0', '0', '2'};
+static constexpr char kMagicV1[8] = {'C', 'E', 'C', 'O', 'L', '0', '0', '1'};
+
+// min/max de um chunk; só o par correspondente ao tipo da coluna é usado
+struct ChunkStats {
+    int64_t minInt = 0, maxInt = 0;
+    double minFloat = 0.0, maxFloat = 0.0;
+    std::string minString, maxString;
+};
+
+struct ChunkMeta {
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    uint32_t rows = 0;
+    Encoding encoding = Encoding::Plain;
+    ChunkStats stats;
+    uint64_t validityOffset = 0;  // relativo ao início do chunk; 0 = chunk sem nulos
+
+    bool hasNulls() const { return validityOffset != 0; }
+};
+
+struct ColumnMeta {
+    std::string name;
+    ColumnType type = ColumnType::String;
+    std::vector<ChunkMeta> chunks;
+};
+
+// representação textual canônica dos tipos numéricos (ida e volta exata)
+inline std::string formatInt64(int64_t value) {
+    return std::to_string(value);
+}
+
+inline std::string formatFloat64(double value) {
+    char buffer[64];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+}
+
+inline bool parseInt64(std::string_view text, int64_t& out) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+    return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+inline bool parseFloat64(std::string_view text, double& out) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+    return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+// Buffer de escrita com helpers para valores binários
+class ByteWriter {
+public:
+    template <typename V>
+    void put(const V& value) {
+        static_assert(std::is_trivially_copyable<V>::value, "put() needs a trivially copyable type");
+        const char* p = reinterpret_cast<const char*>(&value);
+        bytes_.insert(bytes_.end(), p, p + sizeof(V));
+    }
+
+    void putBytes(const char* data, size_t size) {
+        bytes_.insert(bytes_.end(), data, data + size);
+    }
+
+    void putString(const std::string& value) {
+        put<uint32_t>(static_cast<uint32_t>(value.size()));
+        putBytes(value.data(), value.size());
+    }
+
+    void align(size_t alignment) {
+        while (bytes_.size() % alignment != 0) {
+            bytes_.push_back(0);
+        }
+    }
+
+    size_t size() const { return bytes_.size(); }
+    const std::vector<char>& bytes() const { return bytes_; }
+    void clear() { bytes_.clear(); }
+
+private:
+    std::vector<char> bytes_;
+};
+
+// Leitura sequencial do rodapé com checagem de limites
+class ByteReader {
+public:
+    ByteReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename V>
+    V get() {
+        need(sizeof(V));
+        V value;
+        std::memcpy(&value, data_ + pos_, sizeof(V));
+        pos_ += sizeof(V);
+        return value;
+    }
+
+    std::string getString() {
+        uint32_t length = get<uint32_t>();
+        need(length);
+        std::string value(data_ + pos_, length);
+        pos_ += length;
+        return value;
+    }
+
+private:
+    void need(size_t bytes) const {
+        if (pos_ + bytes > size_) {
+            throw std::runtime_error("Columnar file: truncated footer");
+        }
+    }
+
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+// Visão zero-copy de um chunk de coluna dentro do arquivo mapeado
+class ColumnChunkView {
+public:
+    ColumnChunkView(ColumnType type, const ChunkMeta& meta, const char* base)
+        : type_(type), encoding_(meta.encoding), rows_(meta.rows), base_(base) {
+        if (meta.hasNulls()) {
+            validity_ = reinterpret_cast<const uint64_t*>(base_ + meta.validityOffset);
+        }
+        if (type_ == ColumnType::String) {
+            if (encoding_ == Encoding::Dictionary) {
+                std::memcpy(&dictSize_, base_, sizeof(uint32_t));
+                offsets_ = reinterpret_cast<const uint32_t*>(base_ + sizeof(uint32_t));
+                bytes_ = reinterpret_cast<const char*>(offsets_ + dictSize_ + 1);
+                size_t codesStart = (offsets_[dictSize_] + 3) & ~static_cast<size_t>(3);
+                codes_ = reinterpret_cast<const uint32_t*>(bytes_ + codesStart);
+            } else {
+                offsets_ = reinterpret_cast<const uint32_t*>(base_);
+                bytes_ = reinterpret_cast<const char*>(offsets_ + rows_ + 1);
+            }
+        }
+    }
+
+    ColumnType type() const { return type_; }
+    Encoding encoding() const { return encoding_; }
+    size_t size() const { return rows_; }
+
+    bool hasNulls() const { return validity_ != nullptr; }
+    bool isNull(size_t row) const { return validity_ && !((validity_[row >> 6] >> (row & 63)) & 1); }
+
+    // ponteiros diretos para o arquivo mapeado (colunas numéricas)
+    const int64_t* int64Data() const { return reinterpret_cast<const int64_t*>(base_); }
+    const double* float64Data() const { return reinterpret_cast<const double*>(base_); }
+
+    int64_t int64At(size_t row) const { return int64Data()[row]; }
+    double float64At(size_t row) const { return float64Data()[row]; }
+
+    std::string_view stringAt(size_t row) const {
+        uint32_t index = (encoding_ == Encoding::Dictionary) ? codes_[row] : static_cast<uint32_t>(row);
+        return std::string_view(bytes_ + offsets_[index], offsets_[index + 1] - offsets_[index]);
+    }
+
+    // página de dicionário (colunas string codificadas com dicionário)
+    size_t dictionarySize() const { return dictSize_; }
+    const uint32_t* codes() const { return codes_; }
+    std::string_view dictionaryAt(size_t index) const {
+        return std::string_view(bytes_ + offsets_[index], offsets_[index + 1] - offsets_[index]);
+    }
+
+    // valor em texto, qualquer que seja o tipo ("" para nulos, como no DataFrame)
+    std::string textAt(size_t row) const {
+        if (isNull(row)) {
+            return std::string();
+        }
+        switch (type_) {
+            case ColumnType::Int64:   return formatInt64(int64At(row));
+            case ColumnType::Float64: return formatFloat64(float64At(row));
+            default:                  return std::string(stringAt(row));
+        }
+    }
+
+private:
+    ColumnType type_;
+    Encoding encoding_;
+    uint32_t rows_;
+    const char* base_;
+    const uint32_t* offsets_ = nullptr;
+    const char* bytes_ = nullptr;
+    const uint32_t* codes_ = nullptr;
+    const uint64_t* validity_ = nullptr;
+    uint32_t dictSize_ = 0;
+};
+
+class ColumnarWriter {
+public:
+    // Escreve qualquer DataFrame no formato colunar. Colunas de texto viram int64/float64
+    // quando todos os valores voltam exatamente ao mesmo texto; senão ficam como string.
+    // Nulos são guardados na página de validade do chunk e voltam como nulos na leitura.
+    template <typename T>
+    static void write(const std::string& filePath, const DataFrame<T>& df, size_t chunkRows = 65536) {
+        if (chunkRows == 0 || chunkRows > UINT32_MAX) {
+            throw std::invalid_argument("chunkRows must be between 1 and 2^32 - 1");
+        }
+
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open the file: " + filePath);
+        }
+
+        file.write(kMagic, sizeof(kMagic));
+        uint64_t written = sizeof(kMagic);
+
+        const size_t numRows = df.numRows();
+        std::vector<ColumnMeta> metas;
+        ByteWriter chunk;
+
+        for (const auto& name : df.getColumns()) {
+            const Series<T>& column = df[name];
+            const std::vector<T>& values = column.values();
+            const Bitmap valid = column.validMask();
+
+            ColumnMeta meta;
+            meta.name = name;
+            meta.type = detectType(values, valid);
+
+            for (size_t start = 0; start < numRows; start += chunkRows) {
+                size_t end = std::min(numRows, start + chunkRows);
+
+                chunk.clear();
+                ChunkMeta chunkMeta;
+                chunkMeta.offset = written;
+                chunkMeta.rows = static_cast<uint32_t>(end - start);
+                encodeChunk(values, valid, start, end, meta.type, chunk, chunkMeta);
+                chunk.align(8);
+                if (column.hasNulls()) {
+                    Bitmap chunkValid = valid.slice(start, end);
+                    if (chunkValid.count() != chunkValid.size()) {
+                        chunkMeta.validityOffset = chunk.size();
+                        chunk.putBytes(reinterpret_cast<const char*>(chunkValid.words()),
+                                       chunkValid.numWords() * sizeof(uint64_t));
+                    }
+                }
+                chunkMeta.length = chunk.size();
+
+                file.write(chunk.bytes().data(), chunk.size());
+                written += chunk.size();
+                meta.chunks.push_back(std::move(chunkMeta));
+            }
+            metas.push_back(std::move(meta));
+        }
+
+        // rodapé
+        ByteWriter footer;
+        footer.put<uint64_t>(numRows);
+        footer.put<uint32_t>(static_cast<uint32_t>(chunkRows));
+        footer.put<uint32_t>(static_cast<uint32_t>(metas.size()));
+        for (const auto& meta : metas) {
+            footer.putString(meta.name);
+            footer.put<uint8_t>(static_cast<uint8_t>(meta.type));
+            footer.put<uint32_t>(static_cast<uint32_t>(meta.chunks.size()));
+            for (const auto& chunkMeta : meta.chunks) {
+                footer.put<uint64_t>(chunkMeta.offset);
+                footer.put<uint64_t>(chunkMeta.length);
+                footer.put<uint32_t>(chunkMeta.rows);
+                footer.put<uint8_t>(static_cast<uint8_t>(chunkMeta.encoding));
+                writeStats(footer, meta.type, chunkMeta.stats);
+                footer.put<uint64_t>(chunkMeta.validityOffset);
+            }
+        }
+
+        file.write(footer.bytes().data(), footer.size());
+        file.write(reinterpret_cast<const char*>(&written), sizeof(written));
+        file.write(kMagic, sizeof(kMagic));
+
+        if (!file) {
+            throw std::runtime_error("Error writing the file: " + filePath);
+        }
+    }
+
+private:
+    template <typename T>
+    static std::string toText(const T& value) {
+        if constexpr (std::is_same<T, std::string>::value) {
+            return value;
+        } else {
+            std::ostringstream ss;
+            ss << value;
+            return ss.str();
+        }
+    }
+
+    // tipo da coluna pelos valores presentes (nulos não contam)
+    template <typename T>
+    static ColumnType detectType(const std::vector<T>& values, const Bitmap& valid) {
+        if constexpr (std::is_integral<T>::value) {
+            return ColumnType::Int64;
+        } else if constexpr (std::is_floating_point<T>::value) {
+            return ColumnType::Float64;
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            if (valid.count() == 0) {
+                return ColumnType::String;
+            }
+            bool allInt = true, allFloat = true;
+            for (size_t row = 0; row < values.size(); ++row) {
+                if (!valid.test(row)) continue;
+                const std::string& value = values[row];
+                int64_t i;
+                double d;
+                if (allInt && !(parseInt64(value, i) && formatInt64(i) == value)) allInt = false;
+                if (allFloat && !(parseFloat64(value, d) && formatFloat64(d) == value)) allFloat = false;
+                if (!allInt && !allFloat) break;
+            }
+            return allInt ? ColumnType::Int64 : (allFloat ? ColumnType::Float64 : ColumnType::String);
+        } else {
+            return ColumnType::String;
+        }
+    }
+
+    template <typename T>
+    static int64_t asInt64(const T& value) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            return static_cast<int64_t>(value);
+        } else {
+            int64_t out = 0;
+            parseInt64(toText(value), out);
+            return out;
+        }
+    }
+
+    template <typename T>
+    static double asFloat64(const T& value) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            return static_cast<double>(value);
+        } else {
+            double out = 0.0;
+            parseFloat64(toText(value), out);
+            return out;
+        }
+    }
+
+    // valores numéricos: nulos são gravados como 0 e ficam fora do min/max
+    template <typename T>
+    static void encodeChunk(const std::vector<T>& values, const Bitmap& valid, size_t start, size_t end,
+                            ColumnType type, ByteWriter& out, ChunkMeta& meta) {
+        ChunkStats& stats = meta.stats;
+        meta.encoding = Encoding::Plain;
+
+        if (type == ColumnType::Int64) {
+            bool first = true;
+            for (size_t i = start; i < end; ++i) {
+                int64_t v = valid.test(i) ? asInt64(values[i]) : 0;
+                if (valid.test(i)) {
+                    stats.minInt = first ? v : std::min(stats.minInt, v);
+                    stats.maxInt = first ? v : std::max(stats.maxInt, v);
+                    first = false;
+                }
+                out.put<int64_t>(v);
+            }
+            return;
+        }
+
+        if (type == ColumnType::Float64) {
+            bool first = true;
+            for (size_t i = start; i < end; ++i) {
+                double v = valid.test(i) ? asFloat64(values[i]) : 0.0;
+                if (valid.test(i)) {
+                    stats.minFloat = first ? v : std::min(stats.minFloat, v);
+                    stats.maxFloat = first ? v : std::max(stats.maxFloat, v);
+                    first = false;
+                }
+                out.put<double>(v);
+            }
+            return;
+        }
+
+        // strings: monta o dicionário para decidir a codificação
+        std::vector<std::string> texts;
+        texts.reserve(end - start);
+        for (size_t i = start; i < end; ++i) {
+            texts.push_back(toText(values[i]));
+        }
+
+        stats.minString = *std::min_element(texts.begin(), texts.end());
+        stats.maxString = *std::max_element(texts.begin(), texts.end());
+
+        std::unordered_map<std::string_view, uint32_t> dictionary;
+        std::vector<std::string_view> entries;
+        std::vector<uint32_t> codes;
+        codes.reserve(texts.size());
+        for (const auto& text : texts) {
+            auto it = dictionary.find(text);
+            if (it == dictionary.end()) {
+                it = dictionary.emplace(text, static_cast<uint32_t>(entries.size())).first;
+                entries.push_back(text);
+            }
+            codes.push_back(it->second);
+        }
+
+        if (entries.size() * 2 <= texts.size()) {
+            meta.encoding = Encoding::Dictionary;
+            out.put<uint32_t>(static_cast<uint32_t>(entries.size()));
+            writeStringPage(out, entries);
+            out.align(4);
+            for (uint32_t code : codes) {
+                out.put<uint32_t>(code);
+            }
+        } else {
+            std::vector<std::string_view> views(texts.begin(), texts.end());
+            writeStringPage(out, views);
+        }
+    }
+
+    // u32 offsets[n + 1] seguidos dos bytes concatenados
+    static void writeStringPage(ByteWriter& out, const std::vector<std::string_view>& values) {
+        uint64_t offset = 0;
+        out.put<uint32_t>(0);
+        for (const auto& value : values) {
+            offset += value.size();
+            if (offset > UINT32_MAX) {
+                throw std::runtime_error("Columnar file: string chunk larger than 4 GiB");
+            }
+            out.put<uint32_t>(static_cast<uint32_t>(offset));
+        }
+        for (const auto& value : values) {
+            out.putBytes(value.data(), value.size());
+        }
+    }
+
+    static void writeStats(ByteWriter& out, ColumnType type, const ChunkStats& stats) {
+        if (type == ColumnType::Int64) {
+            out.put<int64_t>(stats.minInt);
+            out.put<int64_t>(stats.maxInt);
+        } else if (type == ColumnType::Float64) {
+            out.put<double>(stats.minFloat);
+            out.put<double>(stats.maxFloat);
+        } else {
+            out.putString(stats.minString);
+            out.putString(stats.maxString);
+        }
+    }
+};
+
+// Leitor: mapeia o arquivo e expõe os chunks sem copiar os dados
+class ColumnarReader {
+public:
+    explicit ColumnarReader(const std::string& filePath) : file_(filePath) {
+        const size_t trailerSize = sizeof(uint64_t) + sizeof(kMagic);
+        if (file_.size() < sizeof(kMagic) + trailerSize) {
+            throw std::runtime_error("Not a columnar file: " + filePath);
+        }
+        const char* magic = file_.data();
+        bool v1 = std::memcmp(magic, kMagicV1, sizeof(kMagic)) == 0;
+        if ((!v1 && std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) ||
+            std::memcmp(file_.data() + file_.size() - sizeof(kMagic), magic, sizeof(kMagic)) != 0) {
+            throw std::runtime_error("Not a columnar file: " + filePath);
+        }
+
+        uint64_t footerOffset;
+        std::memcpy(&footerOffset, file_.data() + file_.size() - trailerSize, sizeof(footerOffset));
+        if (footerOffset > file_.size() - trailerSize) {
+            throw std::runtime_error("Columnar file: invalid footer offset");
+        }
+
+        ByteReader footer(file_.data() + footerOffset, file_.size() - trailerSize - footerOffset);
+        numRows_ = footer.get<uint64_t>();
+        chunkRows_ = footer.get<uint32_t>();
+        uint32_t numColumns = footer.get<uint32_t>();
+        for (uint32_t c = 0; c < numColumns; ++c) {
+            ColumnMeta meta;
+            meta.name = footer.getString();
+            meta.type = static_cast<ColumnType>(footer.get<uint8_t>());
+            uint32_t numChunks = footer.get<uint32_t>();
+            for (uint32_t k = 0; k < numChunks; ++k) {
+                ChunkMeta chunkMeta;
+                chunkMeta.offset = footer.get<uint64_t>();
+                chunkMeta.length = footer.get<uint64_t>();
+                chunkMeta.rows = footer.get<uint32_t>();
+                chunkMeta.encoding = static_cast<Encoding>(footer.get<uint8_t>());
+                readStats(footer, meta.type, chunkMeta.stats);
+                if (!v1) {
+                    chunkMeta.validityOffset = footer.get<uint64_t>();
+                }
+                if (chunkMeta.offset + chunkMeta.length > footerOffset ||
+                    (chunkMeta.hasNulls() &&
+                     chunkMeta.validityOffset + (chunkMeta.rows + 63) / 64 * sizeof(uint64_t) > chunkMeta.length)) {
+                    throw std::runtime_error("Columnar file: chunk outside the data section");
+                }
+                meta.chunks.push_back(std::move(chunkMeta));
+            }
+            columnNames_.push_back(meta.name);
+            columns_.push_back(std::move(meta));
+        }
+    }
+
+    size_t numRows() const { return numRows_; }
+    size_t chunkRows() const { return chunkRows_; }
+    const std::vector<std::string>& getColumns() const { return columnNames_; }
+
+    int columnIndex(const std::string& name) const {
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            if (columns_[i].name == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    const ColumnMeta& column(const std::string& name) const {
+        int index = columnIndex(name);
+        if (index == -1) {
+            throw std::invalid_argument("Column does not exist: " + name);
+        }
+        return columns_[index];
+    }
+
+    size_t numChunks(const std::string& name) const {
+        return column(name).chunks.size();
+    }
+
+    ColumnChunkView chunk(const std::string& name, size_t chunkIndex) const {
+        const ColumnMeta& meta = column(name);
+        const ChunkMeta& chunkMeta = meta.chunks.at(chunkIndex);
+        return ColumnChunkView(meta.type, chunkMeta, file_.data() + chunkMeta.offset);
+    }
+
+    // materializa as colunas pedidas (todas quando projection é vazia) como texto
+    DataFrame<std::string> toDataFrame(const std::vector<std::string>& projection = {}) const {
+        const std::vector<std::string>& names = projection.empty() ? columnNames_ : projection;
+
+        DataFrame<std::string> result;
+        for (const auto& name : names) {
+            std::vector<std::string> values;
+            std::vector<size_t> nulls;
+            values.reserve(numRows_);
+            for (size_t k = 0; k < numChunks(name); ++k) {
+                ColumnChunkView view = chunk(name, k);
+                for (size_t row = 0; row < view.size(); ++row) {
+                    if (view.isNull(row)) nulls.push_back(values.size());
+                    values.push_back(view.textAt(row));
+                }
+            }
+            result.addColumn(name, withNulls(std::move(values), nulls));
+        }
+        return result;
+    }
+
+    // coluna inteira como StringColumn contígua (valores numéricos em texto canônico)
+    StringColumn stringColumn(const std::string& name) const {
+        const ColumnMeta& meta = column(name);
+        StringColumn result;
+        for (size_t k = 0; k < meta.chunks.size(); ++k) {
+            ColumnChunkView view = chunk(name, k);
+            for (size_t row = 0; row < view.size(); ++row) {
+                if (meta.type == ColumnType::String) {
+                    result.append(view.stringAt(row));
+                } else {
+                    result.append(view.textAt(row));
+                }
+            }
+        }
+        return result;
+    }
+
+    // Zone map do arquivo: false quando as estatísticas do chunk garantem que nenhuma linha
+    // satisfaz o predicado (o chunk pode ser pulado sem ser lido). Nulos são comparados como
+    // "" (como no DataFrame), que o min/max numérico não cobre: esses chunks não são pulados.
+    static bool chunkMayMatch(const ColumnMeta& meta, const ChunkMeta& chunkMeta, const ColumnPredicate& predicate) {
+        const ChunkStats& stats = chunkMeta.stats;
+        if (chunkMeta.hasNulls() && meta.type != ColumnType::String) {
+            return true;
+        }
+        switch (meta.type) {
+            case ColumnType::Int64:
+                return !predicate.valueIsNumeric() ||
+                       predicate.mayMatchRange(static_cast<double>(stats.minInt), static_cast<double>(stats.maxInt));
+            case ColumnType::Float64:
+                return !predicate.valueIsNumeric() || predicate.mayMatchRange(stats.minFloat, stats.maxFloat);
+            default:
+                // texto com valor numérico é comparado número a número, então min/max lexicográfico não serve
+                return predicate.valueIsNumeric() || predicate.mayMatchRange(stats.minString, stats.maxString);
+        }
+    }
+
+    // índices dos chunks da coluna do predicado que podem conter linhas aceitas
+    std::vector<size_t> candidateChunks(const ColumnPredicate& predicate) const {
+        const ColumnMeta& meta = column(predicate.column());
+        std::vector<size_t> result;
+        for (size_t k = 0; k < meta.chunks.size(); ++k) {
+            if (chunkMayMatch(meta, meta.chunks[k], predicate)) {
+                result.push_back(k);
+            }
+        }
+        return result;
+    }
+
+    // Como toDataFrame, mas só com as linhas que satisfazem todos os predicados. Chunks
+    // eliminados pelas estatísticas de qualquer predicado não são lidos.
+    DataFrame<std::string> scan(const std::vector<std::string>& projection,
+                                const std::vector<ColumnPredicate>& predicates) const {
+        if (predicates.empty()) {
+            return toDataFrame(projection);
+        }
+        const std::vector<std::string>& names = projection.empty() ? columnNames_ : projection;
+
+        std::vector<const ColumnMeta*> predicateColumns;
+        for (const auto& predicate : predicates) {
+            predicateColumns.push_back(&column(predicate.column()));
+        }
+
+        std::vector<std::vector<std::string>> values(names.size());
+        std::vector<std::vector<size_t>> nulls(names.size());
+        std::vector<size_t> rows;
+        size_t numChunksTotal = columns_.empty() ? 0 : columns_[0].chunks.size();
+        for (size_t k = 0; k < numChunksTotal; ++k) {
+            bool skip = false;
+            for (size_t p = 0; p < predicates.size() && !skip; ++p) {
+                skip = !chunkMayMatch(*predicateColumns[p], predicateColumns[p]->chunks[k], predicates[p]);
+            }
+            if (skip) {
+                continue;
+            }
+
+            // linhas do chunk que passam em todos os predicados
+            rows.clear();
+            for (size_t row = 0; row < columns_[0].chunks[k].rows; ++row) {
+                rows.push_back(row);
+            }
+            for (size_t p = 0; p < predicates.size() && !rows.empty(); ++p) {
+                const ColumnMeta& meta = *predicateColumns[p];
+                ColumnChunkView view(meta.type, meta.chunks[k], file_.data() + meta.chunks[k].offset);
+                size_t kept = 0;
+                for (size_t row : rows) {
+                    if (rowMatches(view, meta.type, row, predicates[p])) {
+                        rows[kept++] = row;
+                    }
+                }
+                rows.resize(kept);
+            }
+
+            for (size_t c = 0; c < names.size() && !rows.empty(); ++c) {
+                ColumnChunkView view = chunk(names[c], k);
+                for (size_t row : rows) {
+                    if (view.isNull(row)) nulls[c].push_back(values[c].size());
+                    values[c].push_back(view.textAt(row));
+                }
+            }
+        }
+
+        DataFrame<std::string> result;
+        for (size_t c = 0; c < names.size(); ++c) {
+            result.addColumn(names[c], withNulls(std::move(values[c]), nulls[c]));
+        }
+        return result;
+    }
+
+private:
+    static Series<std::string> withNulls(std::vector<std::string> values, const std::vector<size_t>& nulls) {
+        Series<std::string> series(std::move(values));
+        for (size_t row : nulls) {
+            series.setNull(row);
+        }
+        return series;
+    }
+
+    static bool rowMatches(const ColumnChunkView& view, ColumnType type, size_t row, const ColumnPredicate& predicate) {
+        if (view.isNull(row)) {
+            return predicate.matches("");
+        }
+        if (predicate.op() != ColumnPredicate::Op::NotEmpty && predicate.valueIsNumeric()) {
+            if (type == ColumnType::Int64) {
+                return predicate.matchesNumber(static_cast<double>(view.int64At(row)));
+            }
+            if (type == ColumnType::Float64) {
+                return predicate.matchesNumber(view.float64At(row));
+            }
+        }
+        return predicate.matches(view.textAt(row));
+    }
+
+    static void readStats(ByteReader& in, ColumnType type, ChunkStats& stats) {
+        if (type == ColumnType::Int64) {
+            stats.minInt = in.get<int64_t>();
+            stats.maxInt = in.get<int64_t>();
+        } else if (type == ColumnType::Float64) {
+            stats.minFloat = in.get<double>();
+            stats.maxFloat = in.get<double>();
+        } else {
+            stats.minString = in.getString();
+            stats.maxString = in.getString();
+        }
+    }
+
+    MappedFile file_;
+    size_t numRows_ = 0;
+    size_t chunkRows_ = 0;
+    std::vector<ColumnMeta> columns_;
+    std::vector<std::string> columnNames_;
+};
+
+} // namespace columnar
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Parser de CSV (RFC 4180) sobre um buffer contíguo (normalmente um MappedFile).
+// Os campos são devolvidos como std::string_view apontando direto para o buffer; só campos
+// com aspas duplicadas ("") precisam ser remontados em memória auxiliar.
+class CsvParser {
+public:
+    CsvParser(const char* data, size_t size, char delimiter = ',')
+        : data_(data), size_(size), delimiter_(delimiter) {}
+
+    size_t size() const { return size_; }
+
+    // posição do primeiro registro (pula o BOM UTF-8, se houver)
+    size_t begin() const {
+        if (size_ >= 3 && static_cast<unsigned char>(data_[0]) == 0xEF &&
+            static_cast<unsigned char>(data_[1]) == 0xBB && static_cast<unsigned char>(data_[2]) == 0xBF) {
+            return 3;
+        }
+        return 0;
+    }
+
+    // Lê o próximo registro a partir de pos (até no máximo end), preenchendo fields.
+    // Só os primeiros maxFields campos são separados; o resto do registro é pulado sem
+    // materializar nada. Linhas em branco são ignoradas. Retorna false quando não há mais
+    // registros. As views de fields só valem até a próxima chamada.
+    bool nextRecord(size_t& pos, size_t end, std::vector<std::string_view>& fields,
+                    size_t maxFields = static_cast<size_t>(-1)) {
+        fields.clear();
+        scratch_.clear();
+
+        // pula linhas vazias
+        while (pos < end && (data_[pos] == '\n' || data_[pos] == '\r')) ++pos;
+        if (pos >= end) {
+            return false;
+        }
+
+        while (true) {
+            if (pos < end && data_[pos] == '"') {
+                pos = parseQuotedField(pos, end, fields);
+            } else {
+                const char* start = data_ + pos;
+                const char* stop = findSpecial(start, data_ + end);
+                // aspas no meio de um campo sem aspas são tratadas como texto
+                while (stop < data_ + end && *stop == '"') {
+                    stop = findSpecial(stop + 1, data_ + end);
+                }
+                fields.emplace_back(start, static_cast<size_t>(stop - start));
+                pos = static_cast<size_t>(stop - data_);
+            }
+
+            if (pos >= end) {
+                return true;
+            }
+
+            char c = data_[pos];
+            if (c == delimiter_) {
+                ++pos;
+                if (fields.size() >= maxFields) {
+                    pos = skipRecord(pos, end);
+                    return true;
+                }
+                // delimitador no fim do arquivo gera um último campo vazio
+                if (pos >= end) {
+                    fields.emplace_back();
+                    return true;
+                }
+                continue;
+            }
+            if (c == '\r') {
+                ++pos;
+                if (pos < end && data_[pos] == '\n') ++pos;
+                return true;
+            }
+            if (c == '\n') {
+                ++pos;
+                return true;
+            }
+            // lixo depois de um campo com aspas: descarta até o próximo separador
+            const char* stop = findSpecial(data_ + pos, data_ + end);
+            while (stop < data_ + end && *stop == '"') {
+                stop = findSpecial(stop + 1, data_ + end);
+            }
+            pos = static_cast<size_t>(stop - data_);
+        }
+    }
+
+    // Estado do leitor de campos entre dois bytes, com as mesmas regras de nextRecord: aspas
+    // só abrem um campo no início dele (no meio de um campo sem aspas são texto), "" dentro de
+    // aspas é uma aspa literal, e '\n' ou '\r' fora de aspas encerram o registro.
+    enum class ScanState : uint8_t { LineStart, FieldStart, Unquoted, Quoted, QuoteSeen };
+    static constexpr size_t kScanStates = 5;
+    using ScanTransitions = std::array<ScanState, kScanStates>;
+
+    // estado no fim de [begin, end) para cada estado possível em begin. Cada faixa do arquivo
+    // é percorrida em paralelo sem saber onde começa; compor as faixas em ordem dá o estado
+    // exato em cada divisão.
+    ScanTransitions scanTransitions(size_t begin, size_t end) const {
+        ScanTransitions states;
+        for (size_t s = 0; s < kScanStates; ++s) {
+            states[s] = static_cast<ScanState>(s);
+        }
+        for (size_t pos = begin; pos < end; ++pos) {
+            uint8_t cls = charClass(data_[pos]);
+            for (auto& state : states) {
+                state = step(state, cls);
+            }
+        }
+        return states;
+    }
+
+    // Início do primeiro registro em pos ou depois dele, dado o estado exato em pos.
+    // Usado para alinhar divisões do arquivo em bytes com fronteiras de registro.
+    size_t nextRecordStart(size_t pos, ScanState state) const {
+        if (pos == 0) {
+            return begin();
+        }
+        for (; state != ScanState::LineStart && pos < size_; ++pos) {
+            state = step(state, charClass(data_[pos]));
+        }
+        return state == ScanState::LineStart ? pos : size_;
+    }
+
+private:
+    // classes de byte do leitor: 0 texto, 1 aspa, 2 delimitador, 3 fim de linha
+    uint8_t charClass(char c) const {
+        if (c == '"') return 1;
+        if (c == delimiter_) return 2;
+        if (c == '\n' || c == '\r') return 3;
+        return 0;
+    }
+
+    static ScanState step(ScanState state, uint8_t cls) {
+        // [estado][classe]: texto, aspa, delimitador, fim de linha
+        static constexpr ScanState table[kScanStates][4] = {
+            /* LineStart  */ {ScanState::Unquoted, ScanState::Quoted, ScanState::FieldStart, ScanState::LineStart},
+            /* FieldStart */ {ScanState::Unquoted, ScanState::Quoted, ScanState::FieldStart, ScanState::LineStart},
+            /* Unquoted   */ {ScanState::Unquoted, ScanState::Unquoted, ScanState::FieldStart, ScanState::LineStart},
+            /* Quoted     */ {ScanState::Quoted, ScanState::QuoteSeen, ScanState::Quoted, ScanState::Quoted},
+            /* QuoteSeen  */ {ScanState::Unquoted, ScanState::Quoted, ScanState::FieldStart, ScanState::LineStart},
+        };
+        return table[static_cast<size_t>(state)][cls];
+    }
+
+    // pula até o fim do registro atual (pos está no início de um campo); retorna o início do próximo
+    size_t skipRecord(size_t pos, size_t end) const {
+        ScanState state = ScanState::FieldStart;
+        for (; pos < end; ++pos) {
+            char c = data_[pos];
+            state = step(state, charClass(c));
+            if (state == ScanState::LineStart) {
+                // "\r\n" conta como um único fim de linha
+                return (c == '\r' && pos + 1 < end && data_[pos + 1] == '\n') ? pos + 2 : pos + 1;
+            }
+        }
+        if (state == ScanState::Quoted) {
+            throw std::runtime_error("CSV: unterminated quoted field");
+        }
+        return end;
+    }
+
+    // campo entre aspas: "" vira ", e delimitadores/quebras de linha são literais
+    size_t parseQuotedField(size_t pos, size_t end, std::vector<std::string_view>& fields) {
+        size_t start = pos + 1;
+        const char* quote = static_cast<const char*>(std::memchr(data_ + start, '"', end - start));
+
+        // caso comum: nenhuma aspa escapada, o campo é uma view direta do buffer
+        if (quote && (quote + 1 >= data_ + end || quote[1] != '"')) {
+            fields.emplace_back(data_ + start, static_cast<size_t>(quote - (data_ + start)));
+            return static_cast<size_t>(quote - data_) + 1;
+        }
+
+        scratch_.emplace_back();
+        std::string& value = scratch_.back();
+        size_t cur = start;
+        while (true) {
+            quote = static_cast<const char*>(std::memchr(data_ + cur, '"', end - cur));
+            if (!quote) {
+                throw std::runtime_error("CSV: unterminated quoted field");
+            }
+            value.append(data_ + cur, static_cast<size_t>(quote - (data_ + cur)));
+            cur = static_cast<size_t>(quote - data_) + 1;
+            if (cur < end && data_[cur] == '"') {
+                value.push_back('"');
+                ++cur;
+                continue;
+            }
+            break;
+        }
+        fields.emplace_back(value);
+        return cur;
+    }
+
+    // primeiro byte que é delimitador, aspa, '\r' ou '\n' (ou end)
+    const char* findSpecial(const char* p, const char* end) const {
+#if defined(__AVX2__)
+        const __m256i delim = _mm256_set1_epi8(delimiter_);
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+        while (end - p >= 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            __m256i hits = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, delim), _mm256_cmpeq_epi8(chunk, quote)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, lf), _mm256_cmpeq_epi8(chunk, cr)));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+            if (mask) {
+                return p + __builtin_ctz(mask);
+            }
+            p += 32;
+        }
+#elif defined(__SSE2__)
+        const __m128i delim = _mm_set1_epi8(delimiter_);
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+        while (end - p >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i hits = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, delim), _mm_cmpeq_epi8(chunk, quote)),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (mask) {
+                return p + __builtin_ctz(mask);
+            }
+            p += 16;
+        }
+#endif
+        for (; p < end; ++p) {
+            char c = *p;
+            if (c == delimiter_ || c == '"' || c == '\n' || c == '\r') {
+                return p;
+            }
+        }
+        return end;
+    }
+
+    const char* data_;
+    size_t size_;
+    char delimiter_;
+    std::deque<std::string> scratch_;  // campos com aspas escapadas (endereços estáveis)
+};
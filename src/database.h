@@ -131,14 +131,26 @@ public:
         // Prepara a query
         sqlite3_prepare_v2(db, insertQuery.c_str(), -1, &stmt, nullptr);
 
+        // Colunas resolvidas uma vez, fora do laço
+        std::vector<ColumnHandle> handles;
+        for (const auto& column : columns) {
+            handles.push_back(df.column(column));
+        }
+
         // Inicia a transação
         sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
 
         // Insere os dados em massa
         for (int i = 0; i < df.numRows(); ++i) {
             for (size_t j = 0; j < columns.size(); ++j) {
-                // std::cout << "Binding column '" << columns[j] << "' with value: " << value.c_str() << std::endl;
-                sqlite3_bind_text(stmt, j + 1, df.getValue(columns[j], i).c_str(), -1, SQLITE_TRANSIENT);
+                // valores nulos viram NULL no banco
+                if (df.isNull(handles[j], i)) {
+                    sqlite3_bind_null(stmt, j + 1);
+                    continue;
+                }
+                // o valor vive no DataFrame até o step, então não precisa ser copiado (SQLITE_STATIC)
+                const std::string& value = df.getValue(handles[j], i);
+                sqlite3_bind_text(stmt, j + 1, value.c_str(), static_cast<int>(value.size()), SQLITE_STATIC);
             }
             sqlite3_step(stmt);
             sqlite3_reset(stmt);
@@ -5,8 +5,37 @@
 #include <iomanip>
 #include <stdexcept>
 #include <map>
+#include <memory_resource>
+#include <string_view>
 #include <algorithm>
+#include <optional>
+#include <numeric>
+#include <future>
 #include "series.hpp"
+#include "zoneMap.hpp"
+#include "filterExpr.hpp"
+#include "bitmap.hpp"
+#include "arena.hpp"
+#include "threadPool.hpp"
+#include "radix.hpp"
+#include "columnStats.hpp"
+#include "groupAggregator.hpp"
+#include "surrogateKey.hpp"
+#include "dateTime.hpp"
+#include "decimal.hpp"
+
+// Coluna já resolvida (índice), obtida uma vez com DataFrame::column(nome) e usada nos
+// laços no lugar do nome. Continua válida enquanto colunas não forem removidas.
+class ColumnHandle {
+public:
+    ColumnHandle() {}
+    explicit ColumnHandle(int index) : index_(index) {}
+
+    int index() const { return index_; }
+
+private:
+    int index_ = -1;
+};
 
 template <typename T>
 class DataFrame {
@@ -19,34 +48,70 @@ public:
         }
 
         for (int i = 0; i < columns.size(); i++) {
-            addColumn(columns[i], series[i]);
+            addColumn(std::move(columns[i]), std::move(series[i]));
         }
-
-        shape.first = series[0].size();  // update no count das linhas
-        shape.second = series.size();    // update no count das colunas
     }
 
     // retornar cópia
-    DataFrame<T> copy() {
+    DataFrame<T> copy() const {
         return DataFrame<T>(columns, series);
     }
 
-    ~DataFrame() {
-        series.clear();
-        columns.clear();
-    }
-
     // adicionar coluna
     void addColumn(const std::string& columnName, const Series<T>& newSeries) {
+        addColumn(std::string(columnName), Series<T>(newSeries));
+    }
+
+    void addColumn(std::string columnName, Series<T>&& newSeries) {
         if (shape.first != 0 && shape.first != newSeries.size()) {
             throw std::invalid_argument("Series must have the same size as the DataFrame.");
         }
-        columns.push_back(columnName);
-        series.push_back(newSeries);
         shape.first = newSeries.size();  
+        columns.push_back(std::move(columnName));
+        series.push_back(std::move(newSeries));
         shape.second = series.size();   
     }
 
+    // reservar espaço para rows linhas em todas as colunas
+    void reserve(size_t rows) {
+        for (auto& s : series) {
+            s.reserve(rows);
+        }
+    }
+
+    // acrescenta as linhas de other no fim deste DataFrame (in-place, sem recriar as colunas).
+    // Um DataFrame sem colunas simplesmente assume as colunas de other.
+    void append(const DataFrame<T>& other) {
+        if (columns.empty()) {
+            *this = other;
+            return;
+        }
+        if (other.columns.empty()) {
+            return;
+        }
+        checkSameColumns(other);
+        for (size_t i = 0; i < series.size(); ++i) {
+            series[i].append(other.series[i]);
+        }
+        shape.first += other.shape.first;
+    }
+
+    void append(DataFrame<T>&& other) {
+        if (columns.empty()) {
+            *this = std::move(other);
+            return;
+        }
+        if (other.columns.empty()) {
+            return;
+        }
+        checkSameColumns(other);
+        for (size_t i = 0; i < series.size(); ++i) {
+            series[i].append(std::move(other.series[i]));
+        }
+        shape.first += other.shape.first;
+        other.shape.first = 0;
+    }
+
     // remover coluna
     void dropColumn(const std::string& columnName) {
         int column = column_id(columnName);
@@ -56,6 +121,9 @@ public:
         columns.erase(columns.begin() + column);
         series.erase(series.begin() + column);
         shape.second = series.size(); 
+        zoneMaps.erase(columnName);
+        columnStats.erase(columnName);
+        surrogateKeyColumns.erase(columnName);
     }
 
     bool columnExists(const std::string& colName) const {
@@ -107,6 +175,43 @@ public:
         return shape.first;
     }
 
+    // resolve o nome da coluna uma única vez
+    ColumnHandle column(const std::string& columnName) const {
+        int colIdx = column_id(columnName);
+        if (colIdx == -1) {
+            throw std::invalid_argument("Column does not exist: " + columnName);
+        }
+        return ColumnHandle(colIdx);
+    }
+
+    // valor de uma célula por handle: sem busca de nome e sem cópia (mesmas checagens da
+    // versão por nome: handle de outra coluna/DataFrame ou linha fora do intervalo lançam)
+    const T& getValue(ColumnHandle column, int row) const {
+        checkCell(column, row);
+        return series[column.index()].values()[row];
+    }
+
+    // true se a célula é nula (ausente na origem), não apenas vazia
+    bool isNull(ColumnHandle column, int row) const {
+        checkCell(column, row);
+        return series[column.index()].isNull(row);
+    }
+
+    bool isNull(const std::string& columnName, int row) const {
+        return isNull(this->column(columnName), row);
+    }
+
+    void updateValue(ColumnHandle column, int row, const T& newValue) {
+        checkCell(column, row);
+        series[column.index()].updateElementAt(row, newValue);
+    }
+
+    // valores da coluna inteira (para laços que percorrem uma coluna só)
+    const std::vector<T>& values(ColumnHandle column) const {
+        checkColumn(column);
+        return series[column.index()].values();
+    }
+
     // retornar valor em uma célula (coluna + linha)
     T getValue(const std::string& columnName, int row) const {
         int colIdx = column_id(columnName);
@@ -119,18 +224,23 @@ public:
         return series[colIdx][row];
     }
 
-    DataFrame<T> extractLines(size_t start, size_t end) {
+    DataFrame<T> extractLines(size_t start, size_t end) const {
         if (start >= end || end > shape.first) {
             throw std::out_of_range("Invalid range for extractLines");
         }
         
         DataFrame<T> result;
         for (size_t i = 0; i < columns.size(); ++i) {
-            Series<T> new_series;
-            for (size_t j = start; j < end; ++j) {
-                new_series.addElement(series[i][j]);
+            result.addColumn(std::string(columns[i]), series[i].slice(start, end));
+        }
+        // as partições levam o recorte das chaves substitutas já calculadas
+        if constexpr (std::is_same<T, std::string>::value) {
+            for (const auto& entry : surrogateKeyColumns) {
+                if (const SurrogateKeyColumn* keys = cachedSurrogateKeys(entry.first)) {
+                    result.setSurrogateKeys(entry.first,
+                                            std::vector<int64_t>(keys->keys().begin() + start, keys->keys().begin() + end));
+                }
             }
-            result.addColumn(columns[i], new_series);
         }
         return result;
     }
@@ -138,59 +248,116 @@ public:
     
     // Função para filtrar as linhas de um DataFrame baseado em uma condição numérica
     DataFrame<T> filter(const std::string& columnName, const std::string& condition, T value) {
+        return filter(FilterExpr<T>::where(columnName, condition, value));
+    }
+
+    // filtro com várias condições (&&, ||): compilado uma vez e avaliado em uma única passada
+    DataFrame<T> filter(const FilterExpr<T>& expr) const {
+        return filter(mask(expr));
+    }
+
+    // máscara das linhas que satisfazem a expressão (pode ser combinada com &, |, ~)
+    Bitmap mask(const FilterExpr<T>& expr) const {
+        CompiledFilter<T> compiled(expr, columns);
+
+        std::vector<const T*> columnData;
+        for (const auto& s : series) {
+            columnData.push_back(s.values().data());
+        }
+        return compiled.evaluate(columnData, shape.first);
+    }
+
+    // Zone map (min/max por bloco) da coluna; é reconstruído se a coluna mudou desde a última vez
+    const ZoneMap<T>& zoneMap(const std::string& columnName, size_t blockRows = ZoneMap<T>::kDefaultBlockRows) {
         int column = column_id(columnName);
         if (column == -1) {
             throw std::invalid_argument("Column does not exist: " + columnName);
         }
 
-        // Criar um DataFrame de resultado que irá conter apenas as linhas que atendem à condição
-        DataFrame<T> result;
+        const Series<T>& s = series[column];
+        auto it = zoneMaps.find(columnName);
+        if (it == zoneMaps.end() || !it->second.isFresh(s.values(), s.version()) || it->second.blockRows() != blockRows) {
+            it = zoneMaps.insert_or_assign(columnName, ZoneMap<T>(s.values(), s.version(), blockRows)).first;
+        }
+        return it->second;
+    }
 
-        // Criar uma série temporária para cada coluna
-        std::vector<Series<T>> tempSeries;  // Vetor para armazenar séries temporárias
+    // Linhas com lo <= valor <= hi na coluna; blocos cuja faixa min/max não cruza [lo, hi] são pulados
+    DataFrame<T> filterRange(const std::string& columnName, const T& lo, const T& hi) {
+        const ZoneMap<T>& zones = zoneMap(columnName);
+        const std::vector<T>& values = series[column_id(columnName)].values();
 
-        // Inicializar as séries temporárias para cada coluna
-        for (const auto& columnName : columns) {
-            tempSeries.push_back(Series<T>());
+        Bitmap mask(shape.first);
+        zones.forEachCandidateBlock(lo, hi, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (zones.inRange(values[i], lo, hi)) {
+                    mask.set(i);
+                }
+            }
+        });
+        return filter(mask);
+    }
+
+    // Estatísticas da coluna (nulos, NDV estimado, min/max inteiros), calculadas na primeira
+    // consulta e reaproveitadas enquanto a coluna não muda. Preenche o cache: não chamar em
+    // paralelo sobre o mesmo DataFrame (groupby só lê o cache e pode)
+    const ColumnStats<T>& stats(const std::string& columnName) {
+        int column = column_id(columnName);
+        if (column == -1) {
+            throw std::invalid_argument("Column does not exist: " + columnName);
         }
 
-        // Filtrar as linhas com base na condição
-        for (int i = 0; i < shape.first; ++i) {
-            T columnValue = series[column][i];  // Valor da coluna para a linha i
-            bool conditionMet = false;
-
-            // Verificar a condição
-            if (condition == ">") {
-                conditionMet = columnValue > value;
-            } else if (condition == "<") {
-                conditionMet = columnValue < value;
-            } else if (condition == ">=") {
-                conditionMet = columnValue >= value;
-            } else if (condition == "<=") {
-                conditionMet = columnValue <= value;
-            } else if (condition == "==") {
-                conditionMet = columnValue == value;
-            } else if (condition == "!=") {
-                conditionMet = columnValue != value;
-            } else {
-                throw std::invalid_argument("Invalid condition: " + condition);
-            }
+        const Series<T>& s = series[column];
+        auto it = columnStats.find(columnName);
+        if (it == columnStats.end() || !it->second.isFresh(s)) {
+            it = columnStats.insert_or_assign(columnName, ColumnStats<T>(s)).first;
+        }
+        return it->second;
+    }
 
-            // Se a condição for atendida, adicionar a linha ao DataFrame de resultado
-            if (conditionMet) {
-                for (int j = 0; j < shape.second; ++j) {
-                    // Adicionar o valor da linha à série temporária correspondente à coluna
-                    tempSeries[j].addElement(series[j][i]);
-                }
+    // Chaves substitutas inteiras de uma coluna de ids ("AAA-12" -> 12, ver surrogateKey.hpp),
+    // calculadas em uma passada na primeira consulta e reaproveitadas enquanto a coluna não muda
+    const SurrogateKeyColumn& surrogateKeys(const std::string& columnName) {
+        static_assert(std::is_same<T, std::string>::value, "surrogateKeys needs a DataFrame<std::string>");
+        int column = column_id(columnName);
+        if (column == -1) {
+            throw std::invalid_argument("Column does not exist: " + columnName);
+        }
+
+        const Series<T>& s = series[column];
+        auto it = surrogateKeyColumns.find(columnName);
+        if (it == surrogateKeyColumns.end() || !it->second.isFresh(s)) {
+            it = surrogateKeyColumns.insert_or_assign(columnName, SurrogateKeyColumn(s)).first;
+        }
+        return it->second;
+    }
+
+    // chaves substitutas já calculadas e válidas para a coluna, ou nullptr (não calcula)
+    const SurrogateKeyColumn* cachedSurrogateKeys(const std::string& columnName) const {
+        if constexpr (std::is_same<T, std::string>::value) {
+            auto it = surrogateKeyColumns.find(columnName);
+            int column = column_id(columnName);
+            if (it != surrogateKeyColumns.end() && column != -1 && it->second.isFresh(series[column])) {
+                return &it->second;
             }
         }
+        return nullptr;
+    }
 
-        // Adicionar as séries temporárias ao DataFrame de resultado
-        for (int j = 0; j < shape.second; ++j) {
-            result.addColumn(columns[j], tempSeries[j]);
+    // associa à coluna chaves calculadas a partir de outro DataFrame (recorte, seleção de linhas)
+    void setSurrogateKeys(const std::string& columnName, std::vector<int64_t> keys) {
+        static_assert(std::is_same<T, std::string>::value, "surrogateKeys needs a DataFrame<std::string>");
+        int column = column_id(columnName);
+        if (column == -1) {
+            throw std::invalid_argument("Column does not exist: " + columnName);
         }
+        surrogateKeyColumns.insert_or_assign(columnName, SurrogateKeyColumn(std::move(keys), series[column]));
+    }
 
-        return result;
+    // groupby restrito a uma janela [lo, hi] de outra coluna (ex.: reservation_time)
+    DataFrame<std::string> groupbyInRange(const std::string& groupByColumn, const std::string& sumColumn,
+                                          const std::string& rangeColumn, const T& lo, const T& hi) {
+        return filterRange(rangeColumn, lo, hi).groupby(groupByColumn, sumColumn);
     }
 
     DataFrame<std::string> groupby(const std::string& groupByColumn, const std::string& sumColumn) {
@@ -205,17 +372,9 @@ public:
             throw std::invalid_argument("Sum column does not exist: " + sumColumn);
         }
 
-        // Utilizar um mapa para agrupar e somar os valores
-        std::map<std::string, double> groupedData;
-
-        // Iterar sobre as linhas do DataFrame
-        for (int i = 0; i < numRows(); ++i) {
-            std::string groupByValue = getValue(groupByColumn, i);  // Obtém o valor da coluna de agrupamento
-            double sumValue = std::stod(getValue(sumColumn, i));   // Obtém o valor da coluna de soma
-
-            // Somar o valor no grupo correspondente
-            groupedData[groupByValue] += sumValue;
-        }
+        // Agrupar e somar só as linhas em que chave e valor não são nulos; a estrutura usada
+        // (vetor denso, dicionário pequeno, hash ou partição por radix) vem das estatísticas da chave
+        std::vector<GroupSum> groups = sumByGroup(groupByColumn, groupByColIdx, sumColIdx);
 
         // Preparar o DataFrame de resultado
         std::vector<std::string> columns = {groupByColumn, sumColumn};
@@ -225,15 +384,68 @@ public:
         };
 
         // Preencher as séries com os resultados agrupados
-        for (const auto& pair : groupedData) {
-            series[0].addElement(pair.first);           // Adiciona o dia
-            series[1].addElement(std::to_string(pair.second)); // Adiciona a soma de preços
+        for (auto& group : groups) {
+            series[0].addElement(std::move(group.key)); // Adiciona o dia
+            series[1].addElement(std::move(group.sumText)); // Adiciona a soma de preços (exata)
         }
 
         // Retorna o DataFrame com o resultado do groupby
         return DataFrame<std::string>(columns, series);
     }
 
+    // groupby por período (hora, dia, mês) de uma coluna de data/hora ISO-8601: cada valor vira
+    // segundos desde 1970 e o período sai de uma divisão inteira, então as chaves do agrupamento
+    // são inteiros (vetor denso para poucos períodos, radixAggregate para muitos). Só os grupos
+    // finais voltam a ser texto ("2025-01-31"); linhas sem data ou sem número válidos ficam de fora.
+    DataFrame<std::string> groupbyTime(const std::string& timeColumn, const std::string& sumColumn,
+                                       TimeUnit unit = TimeUnit::Day) {
+        static_assert(std::is_same<T, std::string>::value, "groupbyTime needs a DataFrame<std::string>");
+        int timeColIdx = column_id(timeColumn);
+        if (timeColIdx == -1) {
+            throw std::invalid_argument("GroupBy column does not exist: " + timeColumn);
+        }
+
+        int sumColIdx = column_id(sumColumn);
+        if (sumColIdx == -1) {
+            throw std::invalid_argument("Sum column does not exist: " + sumColumn);
+        }
+
+        const std::vector<T>& times = series[timeColIdx].values();
+        const std::vector<T>& values = series[sumColIdx].values();
+        std::vector<int64_t> buckets(times.size(), 0);
+        Bitmap dated(times.size());
+        Bitmap valid = series[timeColIdx].validMask() & series[sumColIdx].validMask();
+        valid.forEachSet([&](size_t i) {
+            int64_t seconds;
+            if (parseIsoDateTime(times[i], seconds)) {
+                buckets[i] = timeBucket(seconds, unit);
+                dated.set(i);
+            }
+        });
+
+        // somas exatas em ponto fixo quando os valores são decimais simples (preços)
+        std::vector<Series<std::string>> result(2);
+        DecimalColumn decimals(values, dated);
+        if (decimals.exact()) {
+            for (const auto& group : sumByBucket(buckets, decimals.units(), dated)) {
+                result[0].addElement(formatTimeBucket(group.key, unit));
+                result[1].addElement(decimals.format(group.sum));
+            }
+        } else {
+            // texto que não é número é pulado, como as datas inválidas (sem exceção por linha)
+            std::vector<double> doubles(values.size(), 0.0);
+            Bitmap numeric = dated;
+            dated.forEachSet([&](size_t i) {
+                if (!ColumnPredicate::parseNumber(values[i], doubles[i])) numeric.reset(i);
+            });
+            for (const auto& group : sumByBucket(buckets, doubles, numeric)) {
+                result[0].addElement(formatTimeBucket(group.key, unit));
+                result[1].addElement(std::to_string(group.sum));
+            }
+        }
+        return DataFrame<std::string>({timeColumn, sumColumn}, std::move(result));
+    }
+
     DataFrame<std::string> groupbyMean(const std::string& groupByColumn, const std::string& meanColumn) {
         // Verificar se as colunas existem no DataFrame
         int groupByColIdx = column_id(groupByColumn);
@@ -246,22 +458,8 @@ public:
             throw std::invalid_argument("Mean column does not exist: " + meanColumn);
         }
     
-        // Utilizar um mapa para agrupar e calcular a média
-        struct GroupData {
-            double sum = 0.0;
-            int count = 0;
-        };
-        std::map<std::string, GroupData> groupedData;
-    
-        // Iterar sobre as linhas do DataFrame
-        for (int i = 0; i < numRows(); ++i) {
-            std::string groupByValue = getValue(groupByColumn, i);  // Obtém o valor da coluna de agrupamento
-            double currentValue = std::stod(getValue(meanColumn, i)); // Obtém o valor da coluna para média
-    
-            // Acumular valores para cálculo da média
-            groupedData[groupByValue].sum += currentValue;
-            groupedData[groupByValue].count++;
-        }
+        // Acumular soma e contagem por grupo (linhas em que chave e valor não são nulos)
+        std::vector<GroupSum> groups = sumByGroup(groupByColumn, groupByColIdx, meanColIdx);
     
         // Preparar o DataFrame de resultado
         std::vector<std::string> columns = {groupByColumn, "mean_" + meanColumn};
@@ -271,11 +469,11 @@ public:
         };
     
         // Preencher as séries com os resultados agrupados
-        for (const auto& pair : groupedData) {
-            series[0].addElement(pair.first); // Adiciona o valor de agrupamento
+        for (auto& group : groups) {
+            series[0].addElement(std::move(group.key)); // Adiciona o valor de agrupamento
             
             // Calcula a média e adiciona ao DataFrame
-            double mean = pair.second.sum / pair.second.count;
+            double mean = group.sum / group.count;
             series[1].addElement(std::to_string(mean)); 
         }
     
@@ -297,6 +495,9 @@ public:
         
         // Atualiza o nome da coluna
         columns[colIdx] = newName;
+        zoneMaps.erase(oldName);
+        columnStats.erase(oldName);
+        surrogateKeyColumns.erase(oldName);
     }
 
     void deleteLastLine() {
@@ -319,6 +520,21 @@ public:
         return series[column];
     }
 
+    // acessar coluna pelo nome (somente leitura)
+    const Series<T>& operator[](const std::string& columnName) const {
+        int column = column_id(columnName);
+        if (column == -1) {
+            throw std::invalid_argument("Column does not exist: " + columnName);
+        }
+        return series[column];
+    }
+
+    // acessar coluna por handle (somente leitura)
+    const Series<T>& operator[](ColumnHandle column) const {
+        checkColumn(column);
+        return series[column.index()];
+    }
+
     // acessar várias colunas pelos nome delas
     DataFrame<T> operator[](const std::vector<std::string>& columnNames) {
         DataFrame<T> result;
@@ -329,10 +545,8 @@ public:
     }
 
     // concantenação (adiciona uma embaixo da outra)
-    DataFrame<T> concat(const DataFrame<T>& other) {
-        if (columns != other.columns) {
-            throw std::invalid_argument("DataFrames must have the same columns to concatenate.");
-        }
+    DataFrame<T> concat(const DataFrame<T>& other) const {
+        checkSameColumns(other);
         DataFrame<T> result;
         for (int i = 0; i < columns.size(); ++i) {
             result.addColumn(columns[i], series[i].appendSeries(other.series[i]));
@@ -345,20 +559,127 @@ public:
         if (condition.size() != shape.first) {
             throw std::invalid_argument("Condition series must have the same length as the DataFrame.");
         }
-        
+
+        Bitmap mask(shape.first);
+        const std::vector<bool>& flags = condition.values();
+        for (int i = 0; i < shape.first; ++i) {
+            if (flags[i]) {
+                mask.set(i);
+            }
+        }
+        return filter(mask);
+    }
+
+    // filtrar com uma máscara compactada: cada coluna é compactada de uma vez (gather)
+    DataFrame<T> filter(const Bitmap& mask) const {
+        if (mask.size() != static_cast<size_t>(shape.first)) {
+            throw std::invalid_argument("Mask must have the same length as the DataFrame.");
+        }
+
         DataFrame<T> result;
-        for (const auto& column : columns) {
-            result.addColumn(column, Series<T>());
+        for (size_t j = 0; j < columns.size(); ++j) {
+            result.addColumn(std::string(columns[j]), series[j].gather(mask));
         }
-    
-        for (int i = 0; i < shape.first; ++i) {
-            if (condition[i]) { 
-                for (int j = 0; j < shape.second; ++j) {
-                    result[columns[j]].addElement(series[j][i]);
+        return result;
+    }
+
+    // linhas nas posições indicadas, nessa ordem
+    DataFrame<T> take(const std::vector<size_t>& rows) const {
+        DataFrame<T> result;
+        for (size_t j = 0; j < columns.size(); ++j) {
+            result.addColumn(std::string(columns[j]), series[j].take(rows));
+        }
+        return result;
+    }
+
+    // Ordena pelas colunas keys (ascending[i] vale para keys[i]; padrão crescente). A ordenação
+    // é estável e colunas de texto com valores todos numéricos são comparadas como números;
+    // nulos ficam no fim. Chaves inteiras ou de texto de largura fixa, sem nulos, usam radix
+    // sort (LSD). Nos demais casos, com um pool, cada thread ordena uma faixa das linhas e as
+    // faixas são intercaladas em rodadas de merge paralelas. Não chamar de dentro de uma tarefa
+    // do próprio pool.
+    DataFrame<T> sortBy(const std::vector<std::string>& keys, const std::vector<bool>& ascending = {},
+                        ThreadPool* pool = nullptr) const {
+        std::vector<SortKey> sortKeys = makeSortKeys(keys, ascending);
+        auto less = [&sortKeys](size_t a, size_t b) { return compareRows(sortKeys, a, b) < 0; };
+
+        const size_t rows = static_cast<size_t>(shape.first);
+        std::vector<size_t> order(rows);
+        std::iota(order.begin(), order.end(), size_t(0));
+
+        std::vector<std::vector<uint64_t>> radixKeys;
+        if (makeRadixKeys(sortKeys, radixKeys)) {
+            // da palavra menos significativa para a mais significativa (cada passada é estável)
+            for (size_t k = radixKeys.size(); k-- > 0;) {
+                radixSortBy(order, radixKeys[k]);
+            }
+            return take(order);
+        }
+
+        std::vector<size_t> bounds = splitRows(rows, pool);
+        size_t parts = bounds.size() - 1;
+        runParts(pool, parts, [&](size_t p) {
+            std::stable_sort(order.begin() + bounds[p], order.begin() + bounds[p + 1], less);
+        });
+
+        // merge das faixas duas a duas; std::merge mantém a estabilidade (a faixa da esquerda vence empates)
+        std::vector<size_t> merged(rows);
+        for (size_t width = 1; width < parts; width *= 2) {
+            size_t pairs = (parts + 2 * width - 1) / (2 * width);
+            runParts(pool, pairs, [&](size_t k) {
+                size_t lo = bounds[k * 2 * width];
+                size_t mid = bounds[std::min(parts, k * 2 * width + width)];
+                size_t hi = bounds[std::min(parts, k * 2 * width + 2 * width)];
+                std::merge(order.begin() + lo, order.begin() + mid, order.begin() + mid, order.begin() + hi,
+                           merged.begin() + lo, less);
+            });
+            order.swap(merged);
+        }
+
+        return take(order);
+    }
+
+    // As k linhas com os maiores valores de columnName, em ordem decrescente (nulos ignorados).
+    // Cada thread mantém um heap limitado a k elementos sobre a sua faixa (O(n log k)) e os
+    // candidatos das threads são unidos no fim.
+    DataFrame<T> topK(const std::string& columnName, size_t k, ThreadPool* pool = nullptr) const {
+        std::vector<SortKey> sortKeys = makeSortKeys({columnName}, {false});
+        // a antes de b: valor maior, ou valor igual e linha anterior
+        auto better = [&sortKeys](size_t a, size_t b) {
+            int c = compareRows(sortKeys, a, b);
+            return c < 0 || (c == 0 && a < b);
+        };
+        const Series<T>& values = *sortKeys[0].series;
+
+        std::vector<size_t> bounds = splitRows(static_cast<size_t>(shape.first), pool);
+        size_t parts = bounds.size() - 1;
+        // heap de cada faixa: o topo é o pior dos k guardados
+        std::vector<std::vector<size_t>> heaps(parts);
+        runParts(pool, parts, [&](size_t p) {
+            std::vector<size_t>& heap = heaps[p];
+            heap.reserve(k);
+            for (size_t i = bounds[p]; i < bounds[p + 1] && k > 0; ++i) {
+                if (values.isNull(i)) continue;
+                if (heap.size() < k) {
+                    heap.push_back(i);
+                    std::push_heap(heap.begin(), heap.end(), better);
+                } else if (better(i, heap.front())) {
+                    std::pop_heap(heap.begin(), heap.end(), better);
+                    heap.back() = i;
+                    std::push_heap(heap.begin(), heap.end(), better);
                 }
             }
+        });
+
+        std::vector<size_t> candidates;
+        for (const auto& heap : heaps) {
+            candidates.insert(candidates.end(), heap.begin(), heap.end());
         }
-        return result;
+        std::sort(candidates.begin(), candidates.end(), better);
+        if (candidates.size() > k) {
+            candidates.resize(k);
+        }
+        return take(candidates);
     }
 
     // somar valores da coluna
@@ -367,10 +688,10 @@ public:
         if (column == -1) {
             throw std::invalid_argument("Column does not exist: " + columnName);
         }
+        // nulos não entram na soma
+        const std::vector<T>& values = series[column].values();
         T total = 0;
-        for (int i = 0; i < shape.first; ++i) {
-            total += series[column][i];
-        }
+        series[column].validMask().forEachSet([&](size_t i) { total += values[i]; });
         return total;
     }
 
@@ -380,8 +701,13 @@ public:
         if (column == -1) {
             throw std::invalid_argument("Column does not exist: " + columnName);
         }
+        // só valores presentes; sem nenhum (coluna vazia ou toda nula) não há média, como em max()
+        size_t present = shape.first - series[column].nullCount();
+        if (present == 0) {
+            throw std::out_of_range("Column has no values: " + columnName);
+        }
         T total = sum(columnName);
-        return total / shape.first;
+        return total / static_cast<T>(present);
     }
 
     // máximo de uma coluna
@@ -390,13 +716,20 @@ public:
         if (column == -1) {
             throw std::invalid_argument("Column does not exist: " + columnName);
         }
-        T maxVal = series[column][0];
-        for (int i = 1; i < shape.first; ++i) {
-            T value = series[column][i];
-            if (value > maxVal) {
-                maxVal = value;
-            }
+        // primeiro valor não nulo como ponto de partida; nulos são ignorados
+        const std::vector<T>& values = series[column].values();
+        Bitmap valid = series[column].validMask();
+        if (valid.count() == 0) {
+            throw std::out_of_range("Column has no values: " + columnName);
         }
+        bool first = true;
+        T maxVal = T();
+        valid.forEachSet([&](size_t i) {
+            if (first || values[i] > maxVal) {
+                maxVal = values[i];
+                first = false;
+            }
+        });
         return maxVal;
     }
 
@@ -441,31 +774,267 @@ DataFrame<T> extractFirstNLines(int n) {
         throw std::out_of_range("Cannot extract more lines than available in DataFrame");
     }
     
-    // Cria novo DataFrame com as mesmas colunas
-    DataFrame<T> result;
-    for (const auto& col : columns) {
-        result.addColumn(col, Series<T>());
-    }
-    
-    // Extrai as linhas
-    for (int i = 0; i < n; ++i) {
-        // Pega a primeira linha do DataFrame original
-        std::vector<T> line;
-        for (int j = 0; j < shape.second; ++j) {
-            line.push_back(series[j][0]);
-        }
-        
-        // Adiciona ao novo DataFrame
-        result.addLine(line);
-        
-        // Remove do DataFrame original
-        deleteLine(0);  // Sempre remove a primeira linha (índice 0)
+    // Copia as N linhas de uma vez e remove-as da frente de cada coluna com um único erase
+    // (O(linhas) por chamada). Para consumo FIFO repetido use ChunkedDataFrame, que faz o
+    // mesmo em O(1) amortizado por linha.
+    DataFrame<T> result = extractLines(0, n);
+    for (auto& s : series) {
+        s.removeFirst(n);
     }
+    shape.first -= n;
 
     return result;
 }
 
 private:
+    // soma e contagem de um grupo; sumText é a soma já em texto
+    struct GroupSum {
+        std::string key;
+        std::string sumText;
+        double sum;
+        size_t count;
+    };
+
+    // Soma por grupo da coluna de valores (linhas em que chave e valor não são nulos). Se todos
+    // os valores são decimais simples ("123.45") a soma é feita em ponto fixo com int64 e o
+    // texto é exato; senão cada valor passa por std::stod uma vez e a soma é em double.
+    std::vector<GroupSum> sumByGroup(const std::string& groupByColumn, int groupByColIdx, int valueColIdx) {
+        static_assert(std::is_same<T, std::string>::value, "groupby needs a DataFrame<std::string>");
+        Bitmap valid = series[groupByColIdx].validMask() & series[valueColIdx].validMask();
+        const std::vector<T>& keys = series[groupByColIdx].values();
+        const std::vector<T>& values = series[valueColIdx].values();
+
+        // estatísticas do cache se ainda valem; senão calculadas só para esta chamada, sem
+        // escrever no cache (groupby continua podendo rodar em paralelo no mesmo DataFrame)
+        std::optional<ColumnStats<T>> localStats;
+        const ColumnStats<T>* keyStats = nullptr;
+        auto cached = columnStats.find(groupByColumn);
+        if (cached != columnStats.end() && cached->second.isFresh(series[groupByColIdx])) {
+            keyStats = &cached->second;
+        } else {
+            keyStats = &localStats.emplace(series[groupByColIdx]);
+        }
+
+        std::vector<GroupSum> result;
+        DecimalColumn decimals(values, valid);
+        if (decimals.exact()) {
+            for (auto& group : GroupAggregator<int64_t>::aggregate(keys, decimals.units(), valid, *keyStats)) {
+                result.push_back({std::move(group.key), decimals.format(group.sum), decimals.toDouble(group.sum), group.count});
+            }
+        } else {
+            std::vector<double> doubles(values.size(), 0.0);
+            valid.forEachSet([&](size_t i) { doubles[i] = std::stod(values[i]); });
+            for (auto& group : GroupAggregator<double>::aggregate(keys, doubles, valid, *keyStats)) {
+                result.push_back({std::move(group.key), std::to_string(group.sum), group.sum, group.count});
+            }
+        }
+        return result;
+    }
+
+    // soma por período (linhas de rows), em ordem de período: vetor denso para poucos
+    // períodos, radixAggregate para muitos
+    template <typename V>
+    static std::vector<KeyAggregate<V>> sumByBucket(const std::vector<int64_t>& buckets, const std::vector<V>& values,
+                                                    const Bitmap& rows) {
+        std::vector<int64_t> keys;
+        std::vector<V> sums;
+        keys.reserve(rows.count());
+        sums.reserve(rows.count());
+        rows.forEachSet([&](size_t i) {
+            keys.push_back(buckets[i]);
+            sums.push_back(values[i]);
+        });
+
+        std::vector<KeyAggregate<V>> groups;
+        if (keys.empty()) return groups;
+        auto [lo, hi] = std::minmax_element(keys.begin(), keys.end());
+        uint64_t range = static_cast<uint64_t>(*hi - *lo) + 1;
+        if (range <= kDenseMaxRange) {
+            std::vector<KeyAggregate<V>> dense(range, {0, V(), 0});
+            for (size_t i = 0; i < keys.size(); ++i) {
+                KeyAggregate<V>& group = dense[keys[i] - *lo];
+                group.sum += sums[i];
+                ++group.count;
+            }
+            for (uint64_t k = 0; k < range; ++k) {
+                if (dense[k].count) groups.push_back({*lo + static_cast<int64_t>(k), dense[k].sum, dense[k].count});
+            }
+        } else {
+            groups = radixAggregate(keys, sums);
+            std::sort(groups.begin(), groups.end(),
+                      [](const KeyAggregate<V>& a, const KeyAggregate<V>& b) { return a.key < b.key; });
+        }
+        return groups;
+    }
+
+    // chave de ordenação já resolvida; texto numérico é convertido uma única vez
+    struct SortKey {
+        const Series<T>* series = nullptr;
+        std::vector<double> numbers;  // preenchido só para colunas de texto numéricas
+        bool numeric = false;
+        bool integral = false;        // todos os valores são inteiros (T inteiro ou texto inteiro)
+        bool ascending = true;
+    };
+
+    std::vector<SortKey> makeSortKeys(const std::vector<std::string>& keys, const std::vector<bool>& ascending) const {
+        if (keys.empty()) {
+            throw std::invalid_argument("At least one sort key is required.");
+        }
+        std::vector<SortKey> sortKeys(keys.size());
+        for (size_t k = 0; k < keys.size(); ++k) {
+            int column = column_id(keys[k]);
+            if (column == -1) {
+                throw std::invalid_argument("Column does not exist: " + keys[k]);
+            }
+            SortKey& key = sortKeys[k];
+            key.series = &series[column];
+            key.ascending = k < ascending.size() ? ascending[k] : true;
+            if constexpr (std::is_integral<T>::value) {
+                key.integral = true;
+            } else if constexpr (std::is_same<T, std::string>::value) {
+                const std::vector<std::string>& values = key.series->values();
+                key.numbers.resize(values.size());
+                key.numeric = true;
+                for (size_t i = 0; i < values.size() && key.numeric; ++i) {
+                    key.numeric = key.series->isNull(i) || ColumnPredicate::parseNumber(values[i], key.numbers[i]);
+                }
+                if (!key.numeric) {
+                    key.numbers.clear();
+                }
+                key.integral = key.numeric;
+                for (size_t i = 0; i < key.numbers.size() && key.integral; ++i) {
+                    double x = key.numbers[i];
+                    key.integral = key.series->isNull(i) || (x == static_cast<double>(static_cast<int64_t>(x)) &&
+                                                             x > -9.0e15 && x < 9.0e15);
+                }
+            }
+        }
+        return sortKeys;
+    }
+
+    // Chaves de radix sort, da mais para a menos significativa: uma palavra por chave inteira e
+    // ceil(largura / 8) palavras (bytes em big-endian) por chave de texto de largura fixa.
+    // Retorna false se alguma chave tem nulos ou não é de um desses tipos.
+    bool makeRadixKeys(const std::vector<SortKey>& keys, std::vector<std::vector<uint64_t>>& out) const {
+        constexpr size_t kMaxFixedWidth = 32;
+        const size_t rows = static_cast<size_t>(shape.first);
+        for (const SortKey& key : keys) {
+            if (key.series->hasNulls()) return false;
+            if (key.integral) continue;
+            if constexpr (std::is_same<T, std::string>::value) {
+                const std::vector<std::string>& values = key.series->values();
+                if (key.numeric || rows == 0 || values[0].size() > kMaxFixedWidth) return false;
+                for (const auto& value : values) {
+                    if (value.size() != values[0].size()) return false;
+                }
+            } else {
+                return false;
+            }
+        }
+
+        for (const SortKey& key : keys) {
+            const uint64_t flip = key.ascending ? 0 : ~uint64_t(0);
+            if (key.integral) {
+                std::vector<uint64_t> words(rows);
+                for (size_t i = 0; i < rows; ++i) {
+                    if constexpr (std::is_integral<T>::value) {
+                        words[i] = orderedBits(key.series->values()[i]) ^ flip;
+                    } else {
+                        words[i] = orderedBits(static_cast<int64_t>(key.numbers[i])) ^ flip;
+                    }
+                }
+                out.push_back(std::move(words));
+                continue;
+            }
+            if constexpr (std::is_same<T, std::string>::value) {
+                const std::vector<std::string>& values = key.series->values();
+                const size_t width = rows ? values[0].size() : 0;
+                for (size_t begin = 0; begin < width; begin += 8) {
+                    std::vector<uint64_t> words(rows);
+                    for (size_t i = 0; i < rows; ++i) {
+                        uint64_t word = 0;
+                        for (size_t b = 0; b < 8; ++b) {
+                            unsigned char c = begin + b < width ? static_cast<unsigned char>(values[i][begin + b]) : 0;
+                            word = (word << 8) | c;
+                        }
+                        words[i] = word ^ flip;
+                    }
+                    out.push_back(std::move(words));
+                }
+            }
+        }
+        return true;
+    }
+
+    // < 0 se a linha a vem antes da linha b, > 0 se depois, 0 se empatam em todas as chaves
+    static int compareRows(const std::vector<SortKey>& keys, size_t a, size_t b) {
+        for (const SortKey& key : keys) {
+            bool nullA = key.series->isNull(a);
+            bool nullB = key.series->isNull(b);
+            if (nullA || nullB) {
+                if (nullA != nullB) return nullA ? 1 : -1;
+                continue;
+            }
+            int c;
+            if (key.numeric) {
+                c = key.numbers[a] < key.numbers[b] ? -1 : (key.numbers[b] < key.numbers[a] ? 1 : 0);
+            } else {
+                const T& va = key.series->values()[a];
+                const T& vb = key.series->values()[b];
+                c = va < vb ? -1 : (vb < va ? 1 : 0);
+            }
+            if (c != 0) return key.ascending ? c : -c;
+        }
+        return 0;
+    }
+
+    // limites das faixas de linhas: uma por thread do pool (faixas pequenas não compensam)
+    static std::vector<size_t> splitRows(size_t rows, ThreadPool* pool) {
+        constexpr size_t kMinRowsPerPart = 4096;
+        size_t parts = pool ? std::max<size_t>(1, std::min(pool->size(), rows / kMinRowsPerPart)) : 1;
+        std::vector<size_t> bounds(parts + 1);
+        for (size_t p = 0; p <= parts; ++p) {
+            bounds[p] = rows * p / parts;
+        }
+        return bounds;
+    }
+
+    // executa f(0..parts-1) no pool (ou na thread atual) e espera todas terminarem
+    template <typename F>
+    static void runParts(ThreadPool* pool, size_t parts, F&& f) {
+        if (!pool || parts <= 1) {
+            for (size_t p = 0; p < parts; ++p) f(p);
+            return;
+        }
+        std::vector<std::future<void>> futures;
+        for (size_t p = 0; p < parts; ++p) {
+            futures.push_back(pool->addTask([&f, p]() { f(p); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+
+    void checkSameColumns(const DataFrame<T>& other) const {
+        if (columns != other.columns) {
+            throw std::invalid_argument("DataFrames must have the same columns to concatenate.");
+        }
+    }
+
+    // handles vêm de column() e valem enquanto colunas não são removidas
+    void checkColumn(ColumnHandle column) const {
+        if (column.index() < 0 || column.index() >= static_cast<int>(series.size())) {
+            throw std::invalid_argument("Column handle does not exist: " + std::to_string(column.index()));
+        }
+    }
+
+    void checkCell(ColumnHandle column, int row) const {
+        checkColumn(column);
+        if (row < 0 || row >= static_cast<int>(series[column.index()].size())) {
+            throw std::out_of_range("Row index out of range.");
+        }
+    }
+
     // achar o index da coluna por nome
     int column_id(const std::string& columnName) const {
         for (size_t i = 0; i < columns.size(); i++) { 
@@ -479,4 +1048,51 @@ private:
     std::vector<std::string> columns;  // nomes das colunas
     std::vector<Series<T>> series;     // series
     std::pair<int, int> shape;         // shape do DF
-};
\ No newline at end of file
+    std::map<std::string, ZoneMap<T>> zoneMaps;  // zone maps já calculados, por coluna
+    std::map<std::string, ColumnStats<T>> columnStats;  // estatísticas já calculadas, por coluna
+    std::map<std::string, SurrogateKeyColumn> surrogateKeyColumns;  // chaves substitutas já calculadas, por coluna
+};
+// Monta um DataFrame linha a linha (ou coluna a coluna) com as colunas já pré-dimensionadas;
+// build() move os vetores para o DataFrame sem copiar nenhum valor.
+template <typename T>
+class DataFrameBuilder {
+public:
+    DataFrameBuilder(std::vector<std::string> columns, size_t expectedRows = 0)
+        : columns_(std::move(columns)), data_(columns_.size()) {
+        for (auto& column : data_) {
+            column.reserve(expectedRows);
+        }
+    }
+
+    void addRow(std::vector<T> row) {
+        if (row.size() != columns_.size()) {
+            throw std::invalid_argument("New line must have the same number of elements as the number of columns.");
+        }
+        for (size_t j = 0; j < row.size(); ++j) {
+            data_[j].push_back(std::move(row[j]));
+        }
+    }
+
+    // acesso direto ao vetor de uma coluna, para preenchimento coluna a coluna
+    std::vector<T>& column(size_t index) {
+        return data_.at(index);
+    }
+
+    size_t numRows() const {
+        return data_.empty() ? 0 : data_[0].size();
+    }
+
+    DataFrame<T> build() {
+        DataFrame<T> result;
+        for (size_t j = 0; j < columns_.size(); ++j) {
+            result.addColumn(std::move(columns_[j]), Series<T>(std::move(data_[j])));
+        }
+        columns_.clear();
+        data_.clear();
+        return result;
+    }
+
+private:
+    std::vector<std::string> columns_;
+    std::vector<std::vector<T>> data_;
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+// Datas e horários ISO-8601 como inteiros: segundos desde 1970-01-01 (UTC) e número do dia.
+// O parser lê posições fixas ("2025-01-31T10:20:30"), sem locale, sscanf ou std::tm; com isso
+// truncar para hora ou dia é uma divisão inteira e os grupos por período têm chaves inteiras.
+
+enum class TimeUnit { Hour, Day, Month };
+
+// divisão com arredondamento para baixo (datas antes de 1970 também caem no período certo)
+inline int64_t floorDiv(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// dias desde 1970-01-01 de uma data do calendário gregoriano (algoritmo de H. Hinnant)
+inline int32_t daysFromCivil(int year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+// inverso de daysFromCivil
+inline void civilFromDays(int32_t days, int& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int>(yoe) + era * 400 + (month <= 2);
+}
+
+namespace datetime_detail {
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// dois dígitos em p; -1 se algum não for dígito
+inline int twoDigits(const char* p) {
+    return isDigit(p[0]) && isDigit(p[1]) ? (p[0] - '0') * 10 + (p[1] - '0') : -1;
+}
+
+inline unsigned daysInMonth(int year, unsigned month) {
+    static const unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : days[month - 1];
+}
+
+inline void appendPadded(std::string& out, int64_t value, int width) {
+    char digits[20];
+    int n = 0;
+    bool negative = value < 0;
+    uint64_t v = negative ? static_cast<uint64_t>(-value) : static_cast<uint64_t>(value);
+    do {
+        digits[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    if (negative) out.push_back('-');
+    for (int i = n; i < width; ++i) out.push_back('0');
+    while (n > 0) out.push_back(digits[--n]);
+}
+
+} // namespace datetime_detail
+
+// "YYYY-MM-DD" (e o que vier depois, ignorado) -> dias desde 1970-01-01
+inline bool parseIsoDay(std::string_view text, int32_t& days) {
+    using namespace datetime_detail;
+    if (text.size() < 10 || text[4] != '-' || text[7] != '-') return false;
+    int hi = twoDigits(text.data()), lo = twoDigits(text.data() + 2);
+    int month = twoDigits(text.data() + 5), day = twoDigits(text.data() + 8);
+    if (hi < 0 || lo < 0 || month < 1 || month > 12 || day < 1) return false;
+    int year = hi * 100 + lo;
+    if (static_cast<unsigned>(day) > daysInMonth(year, static_cast<unsigned>(month))) return false;
+    days = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    return true;
+}
+
+// "YYYY-MM-DD", "YYYY-MM-DD[T ]HH:MM[:SS[.fração]]" com "Z" ou "+HH:MM"/"-HH:MM" opcionais
+// -> segundos desde 1970-01-01 UTC (sem fuso, o horário é tomado como UTC)
+inline bool parseIsoDateTime(std::string_view text, int64_t& seconds) {
+    using namespace datetime_detail;
+    int32_t days;
+    if (!parseIsoDay(text, days)) return false;
+    seconds = static_cast<int64_t>(days) * 86400;
+    if (text.size() == 10) return true;
+
+    if ((text[10] != 'T' && text[10] != ' ') || text.size() < 16 || text[13] != ':') return false;
+    int hour = twoDigits(text.data() + 11), minute = twoDigits(text.data() + 14), second = 0;
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59) return false;
+    size_t pos = 16;
+    if (pos < text.size() && text[pos] == ':') {
+        if (text.size() < 19) return false;
+        second = twoDigits(text.data() + 17);
+        if (second < 0 || second > 60) return false;
+        pos = 19;
+        if (pos < text.size() && (text[pos] == '.' || text[pos] == ',')) {
+            ++pos;
+            size_t digits = pos;
+            while (pos < text.size() && isDigit(text[pos])) ++pos;
+            if (pos == digits) return false;
+        }
+    }
+    seconds += hour * 3600 + minute * 60 + second;
+
+    if (pos == text.size()) return true;
+    if (text[pos] == 'Z') return pos + 1 == text.size();
+    if (text[pos] != '+' && text[pos] != '-') return false;
+    // fuso: +HH:MM ou +HHMM
+    std::string_view zone = text.substr(pos + 1);
+    int zoneHour = zone.size() >= 2 ? twoDigits(zone.data()) : -1;
+    int zoneMinute = zone.size() == 5 && zone[2] == ':' ? twoDigits(zone.data() + 3)
+                     : zone.size() == 4                 ? twoDigits(zone.data() + 2)
+                     : zone.size() == 2                 ? 0
+                                                        : -1;
+    if (zoneHour < 0 || zoneHour > 23 || zoneMinute < 0 || zoneMinute > 59) return false;
+    int offset = zoneHour * 3600 + zoneMinute * 60;
+    seconds -= text[pos] == '+' ? offset : -offset;
+    return true;
+}
+
+// período de um instante: horas, dias ou meses desde 1970-01 (hora e dia são uma divisão)
+inline int64_t timeBucket(int64_t seconds, TimeUnit unit) {
+    switch (unit) {
+        case TimeUnit::Hour:
+            return floorDiv(seconds, 3600);
+        case TimeUnit::Day:
+            return floorDiv(seconds, 86400);
+        case TimeUnit::Month: {
+            int year;
+            unsigned month, day;
+            civilFromDays(static_cast<int32_t>(floorDiv(seconds, 86400)), year, month, day);
+            return (static_cast<int64_t>(year) - 1970) * 12 + (month - 1);
+        }
+    }
+    return 0;
+}
+
+// texto ISO do período: "2025-01-31 10:00:00" (hora), "2025-01-31" (dia), "2025-01" (mês)
+inline std::string formatTimeBucket(int64_t bucket, TimeUnit unit) {
+    using datetime_detail::appendPadded;
+    std::string out;
+    out.reserve(19);
+    int year;
+    unsigned month, day;
+    if (unit == TimeUnit::Month) {
+        year = static_cast<int>(floorDiv(bucket, 12) + 1970);
+        month = static_cast<unsigned>(bucket - floorDiv(bucket, 12) * 12) + 1;
+        appendPadded(out, year, 4);
+        out.push_back('-');
+        appendPadded(out, month, 2);
+        return out;
+    }
+    int64_t days = unit == TimeUnit::Hour ? floorDiv(bucket, 24) : bucket;
+    civilFromDays(static_cast<int32_t>(days), year, month, day);
+    appendPadded(out, year, 4);
+    out.push_back('-');
+    appendPadded(out, month, 2);
+    out.push_back('-');
+    appendPadded(out, day, 2);
+    if (unit == TimeUnit::Hour) {
+        out.push_back(' ');
+        appendPadded(out, bucket - days * 24, 2);
+        out.append(":00:00");
+    }
+    return out;
+}
+
+// "YYYY-MM-DD HH:MM:SS" (UTC) de segundos desde 1970-01-01
+inline std::string formatEpochSeconds(int64_t seconds) {
+    using datetime_detail::appendPadded;
+    int64_t days = floorDiv(seconds, 86400);
+    int64_t rest = seconds - days * 86400;
+    std::string out = formatTimeBucket(days, TimeUnit::Day);
+    out.push_back(' ');
+    appendPadded(out, rest / 3600, 2);
+    out.push_back(':');
+    appendPadded(out, rest / 60 % 60, 2);
+    out.push_back(':');
+    appendPadded(out, rest % 60, 2);
+    return out;
+}
+
+// texto ISO truncado para o período (ex.: dia "2025-01-31T10:20:30" -> "2025-01-31");
+// false se o texto não é uma data/hora ISO-8601
+inline bool truncateIsoDateTime(std::string_view text, TimeUnit unit, std::string& out) {
+    int64_t seconds;
+    if (!parseIsoDateTime(text, seconds)) return false;
+    out = formatTimeBucket(timeBucket(seconds, unit), unit);
+    return true;
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include "bitmap.hpp"
+
+// Decimais em ponto fixo: o valor é um inteiro escalado por 10^escala ("123.45" na escala 2 ->
+// 12345). Preços chegam como texto; lidos assim uma vez, somas são exatas e feitas com int64,
+// e o texto de saída não passa por double/std::to_string.
+
+constexpr int kMaxDecimalScale = 6;
+
+constexpr int64_t kPow10[] = {1,
+                              10,
+                              100,
+                              1000,
+                              10000,
+                              100000,
+                              1000000,
+                              10000000,
+                              100000000,
+                              1000000000,
+                              10000000000,
+                              100000000000,
+                              1000000000000,
+                              10000000000000,
+                              100000000000000,
+                              1000000000000000,
+                              10000000000000000,
+                              100000000000000000,
+                              1000000000000000000};
+
+// "-123.4500" -> mantissa -12345, escala 2 (zeros no fim da fração não contam). Aceita sinal,
+// dígitos e um '.' opcional; false para outro formato ou mais de 18 dígitos significativos.
+inline bool parseDecimal(std::string_view text, int64_t& mantissa, int& scale) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+    while (i < text.size() && text[i] == '0') ++i;  // zeros à esquerda
+
+    uint64_t value = 0;
+    int digits = 0, fraction = 0, pendingZeros = 0;
+    bool anyDigit = i > 0 && text[i - 1] == '0', point = false;
+    for (; i < text.size(); ++i) {
+        char c = text[i];
+        if (c == '.' && !point) {
+            point = true;
+            continue;
+        }
+        if (c < '0' || c > '9') return false;
+        anyDigit = true;
+        if (point && c == '0') {
+            ++pendingZeros;  // só entra no valor se vier outro dígito depois
+            continue;
+        }
+        for (; pendingZeros > 0; --pendingZeros) {
+            value *= 10;
+            ++fraction;
+            if (value != 0 && ++digits > 18) return false;
+        }
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+        if (point) ++fraction;
+        if (value != 0 && ++digits > 18) return false;
+    }
+    if (!anyDigit) return false;
+    mantissa = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+    scale = fraction;
+    return true;
+}
+
+// texto exato de um decimal: formatDecimal(-1230, 2) == "-12.30"
+inline std::string formatDecimal(int64_t units, int scale) {
+    bool negative = units < 0;
+    uint64_t v = negative ? 0 - static_cast<uint64_t>(units) : static_cast<uint64_t>(units);
+    char digits[24];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v != 0 || n <= scale);
+
+    std::string out;
+    out.reserve(n + 2);
+    if (negative) out.push_back('-');
+    while (n > 0) {
+        if (n == scale) out.push_back('.');
+        out.push_back(digits[--n]);
+    }
+    return out;
+}
+
+// valor em centavos; casas além da segunda arredondam (metade para longe de zero). Texto em
+// outro formato ("1e3") ainda é aceito via strtod.
+inline bool parseCents(std::string_view text, int64_t& cents) {
+    int64_t mantissa;
+    int scale;
+    if (parseDecimal(text, mantissa, scale)) {
+        if (scale <= 2) {
+            return !__builtin_mul_overflow(mantissa, kPow10[2 - scale], &cents);
+        }
+        int64_t divisor = kPow10[scale - 2];
+        int64_t half = divisor / 2;
+        cents = (mantissa + (mantissa < 0 ? -half : half)) / divisor;
+        return true;
+    }
+    std::string copy(text);
+    char* end = nullptr;
+    double value = std::strtod(copy.c_str(), &end);
+    if (copy.empty() || end != copy.c_str() + copy.size() || !std::isfinite(value) || std::fabs(value) > 9e16) {
+        return false;
+    }
+    cents = std::llround(value * 100.0);
+    return true;
+}
+
+// soma exata de dois decimais em texto ("0.1" + "0.2" == "0.3"); false se algum não é decimal
+inline bool addDecimalText(std::string_view a, std::string_view b, std::string& out) {
+    int64_t ma, mb;
+    int sa, sb;
+    if (!parseDecimal(a, ma, sa) || !parseDecimal(b, mb, sb)) return false;
+    int scale = std::max(sa, sb);
+    int64_t sum;
+    if (__builtin_mul_overflow(ma, kPow10[scale - sa], &ma) || __builtin_mul_overflow(mb, kPow10[scale - sb], &mb) ||
+        __builtin_add_overflow(ma, mb, &sum)) {
+        return false;
+    }
+    out = formatDecimal(sum, scale);
+    return true;
+}
+
+// Coluna decimal: os valores (só nas linhas de rows) como inteiros em uma escala comum, a maior
+// entre as linhas (até kMaxDecimalScale). A soma é um laço simples sobre int64 contíguos, que o
+// compilador vetoriza. exact() é false se algum valor não é um decimal simples, tem mais casas
+// que kMaxDecimalScale, não cabe em int64 na escala comum ou se a soma dos módulos não cabe em
+// int64; quem chama volta para double. Assim nenhuma soma de um subconjunto das linhas (total ou
+// por grupo) transborda, e os laços de soma não precisam testar overflow a cada linha.
+class DecimalColumn {
+public:
+    DecimalColumn() {}
+
+    DecimalColumn(const std::vector<std::string>& values, const Bitmap& rows) : units_(values.size(), 0) {
+        std::vector<uint8_t> scales(values.size(), 0);
+        rows.forEachSet([&](size_t i) {
+            if (!exact_) return;
+            int scale;
+            if (!parseDecimal(values[i], units_[i], scale) || scale > kMaxDecimalScale) {
+                exact_ = false;
+                return;
+            }
+            scales[i] = static_cast<uint8_t>(scale);
+            scale_ = std::max(scale_, scale);
+        });
+        if (!exact_) return;
+
+        // segunda passada só com inteiros: tudo para a escala comum, somando os módulos
+        int64_t magnitude = 0;
+        for (size_t i = 0; i < units_.size(); ++i) {
+            if (scales[i] != scale_ && __builtin_mul_overflow(units_[i], kPow10[scale_ - scales[i]], &units_[i])) {
+                exact_ = false;
+                return;
+            }
+            if (units_[i] == INT64_MIN ||
+                __builtin_add_overflow(magnitude, units_[i] < 0 ? -units_[i] : units_[i], &magnitude)) {
+                exact_ = false;
+                return;
+            }
+        }
+    }
+
+    bool exact() const { return exact_; }
+    int scale() const { return scale_; }
+
+    // valores escalados (0 fora de rows)
+    const std::vector<int64_t>& units() const { return units_; }
+
+    // não transborda: a soma dos módulos coube em int64 no construtor
+    int64_t sum() const {
+        int64_t total = 0;
+        for (int64_t value : units_) total += value;
+        return total;
+    }
+
+    std::string format(int64_t units) const { return formatDecimal(units, scale_); }
+    double toDouble(int64_t units) const { return static_cast<double>(units) / static_cast<double>(kPow10[scale_]); }
+
+private:
+    std::vector<int64_t> units_;
+    int scale_ = 0;
+    bool exact_ = true;
+};
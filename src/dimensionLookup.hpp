@@ -0,0 +1,231 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <stdexcept>
+#include <algorithm>
+#include "columnStats.hpp"
+
+// Índice inteiro -> posição. Chaves densas (ids 1..n de voos e usuários) viram um vetor
+// indexado por chave - min: a busca é uma subtração, uma comparação e uma leitura. Chaves
+// esparsas usam uma tabela plana de endereçamento aberto.
+class IntIndex {
+public:
+    static constexpr uint64_t kMaxDenseRange = uint64_t(1) << 22;
+
+    IntIndex() {}
+
+    // posição i para keys[i]; em chaves repetidas vale a última, como em map[key] = i
+    explicit IntIndex(const std::vector<int64_t>& keys) {
+        if (keys.empty()) return;
+        int64_t lo = keys[0], hi = keys[0];
+        for (int64_t key : keys) {
+            lo = std::min(lo, key);
+            hi = std::max(hi, key);
+        }
+        uint64_t range = static_cast<uint64_t>(hi - lo) + 1;
+        if (range <= kMaxDenseRange && range <= 4 * keys.size() + 1024) {
+            min_ = lo;
+            dense_.assign(range, -1);
+            for (size_t i = 0; i < keys.size(); ++i) {
+                dense_[keys[i] - lo] = static_cast<int32_t>(i);
+            }
+            return;
+        }
+
+        size_t capacity = 16;
+        while (capacity < 2 * keys.size()) capacity <<= 1;
+        slots_.assign(capacity, Slot());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            Slot& slot = probe(keys[i]);
+            slot.key = keys[i];
+            slot.position = static_cast<int32_t>(i);
+        }
+    }
+
+    bool isDense() const { return !dense_.empty(); }
+
+    // posição da chave, ou -1
+    int32_t find(int64_t key) const {
+        if (!dense_.empty()) {
+            uint64_t offset = static_cast<uint64_t>(key - min_);
+            return offset < dense_.size() ? dense_[offset] : -1;
+        }
+        if (slots_.empty()) return -1;
+        size_t mask = slots_.size() - 1;
+        for (size_t s = hash(key) & mask;; s = (s + 1) & mask) {
+            if (slots_[s].position == -1) return -1;
+            if (slots_[s].key == key) return slots_[s].position;
+        }
+    }
+
+private:
+    struct Slot {
+        int64_t key = 0;
+        int32_t position = -1;  // -1 = vazio
+    };
+
+    static size_t hash(int64_t key) {
+        uint64_t h = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+    Slot& probe(int64_t key) {
+        size_t mask = slots_.size() - 1;
+        size_t s = hash(key) & mask;
+        while (slots_[s].position != -1 && slots_[s].key != key) s = (s + 1) & mask;
+        return slots_[s];
+    }
+
+    int64_t min_ = 0;
+    std::vector<int32_t> dense_;
+    std::vector<Slot> slots_;
+};
+
+// Tabela de dimensão (ex.: user_id -> country). Chaves de texto que são inteiros canônicos vão
+// para um IntIndex; as demais (se houver) ficam em um unordered_map de reserva. A busca não
+// cria strings temporárias.
+template <typename V>
+class DimensionLookup {
+public:
+    DimensionLookup() {}
+
+    static DimensionLookup build(const std::vector<std::string>& keys, const std::vector<V>& values) {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values must have the same size");
+        }
+        DimensionLookup lookup;
+        std::vector<int64_t> intKeys;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            int64_t key;
+            if (parseCanonicalInt(keys[i], key)) {
+                intKeys.push_back(key);
+                lookup.values_.push_back(values[i]);
+            } else {
+                lookup.others_[keys[i]] = values[i];
+            }
+        }
+        lookup.ints_ = IntIndex(intKeys);
+        return lookup;
+    }
+
+    static DimensionLookup build(const std::vector<int64_t>& keys, std::vector<V> values) {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values must have the same size");
+        }
+        DimensionLookup lookup;
+        lookup.ints_ = IntIndex(keys);
+        lookup.values_ = std::move(values);
+        return lookup;
+    }
+
+    // valor da chave, ou nullptr
+    const V* find(int64_t key) const {
+        int32_t position = ints_.find(key);
+        return position < 0 ? nullptr : &values_[position];
+    }
+
+    const V* find(std::string_view key) const {
+        int64_t intKey;
+        if (parseCanonicalInt(key, intKey)) {
+            return find(intKey);
+        }
+        if (others_.empty()) return nullptr;
+        auto it = others_.find(std::string(key));
+        return it == others_.end() ? nullptr : &it->second;
+    }
+
+    bool isDense() const { return ints_.isDense(); }
+
+private:
+    IntIndex ints_;
+    std::vector<V> values_;
+    std::unordered_map<std::string, V> others_;
+};
+
+// Tabela de dimensão com chave composta (inteiro, texto curto), ex.: (voo, assento) -> classe.
+// Os textos das chaves ficam em um único buffer e a busca recebe um string_view: nenhuma
+// chave "voo_assento" é montada por linha.
+template <typename V>
+class CompositeLookup {
+public:
+    CompositeLookup() {}
+
+    // firstKeys[i] que não são inteiros canônicos são ignorados
+    static CompositeLookup build(const std::vector<std::string>& firstKeys, const std::vector<std::string>& secondKeys,
+                                 const std::vector<V>& values) {
+        if (firstKeys.size() != secondKeys.size() || firstKeys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values must have the same size");
+        }
+        CompositeLookup lookup;
+        size_t capacity = 16;
+        while (capacity < 2 * firstKeys.size()) capacity <<= 1;
+        lookup.slots_.assign(capacity, Slot());
+
+        for (size_t i = 0; i < firstKeys.size(); ++i) {
+            int64_t first;
+            if (!parseCanonicalInt(firstKeys[i], first)) continue;
+            std::string_view second = secondKeys[i];
+            size_t h = hash(first, second);
+            Slot& slot = lookup.slots_[lookup.probe(first, second, h)];
+            if (slot.position == -1) {
+                slot.first = first;
+                slot.hash = h;
+                slot.secondBegin = static_cast<uint32_t>(lookup.bytes_.size());
+                slot.secondSize = static_cast<uint32_t>(second.size());
+                lookup.bytes_.insert(lookup.bytes_.end(), second.begin(), second.end());
+                slot.position = static_cast<int32_t>(lookup.values_.size());
+                lookup.values_.push_back(values[i]);
+            } else {
+                lookup.values_[slot.position] = values[i];
+            }
+        }
+        return lookup;
+    }
+
+    // valor da chave (first, second), ou nullptr
+    const V* find(int64_t first, std::string_view second) const {
+        if (slots_.empty()) return nullptr;
+        const Slot& slot = slots_[probe(first, second, hash(first, second))];
+        return slot.position == -1 ? nullptr : &values_[slot.position];
+    }
+
+    size_t size() const { return values_.size(); }
+
+private:
+    struct Slot {
+        int64_t first = 0;
+        size_t hash = 0;
+        uint32_t secondBegin = 0;
+        uint32_t secondSize = 0;
+        int32_t position = -1;  // -1 = vazio
+    };
+
+    static size_t hash(int64_t first, std::string_view second) {
+        uint64_t h = static_cast<uint64_t>(first) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (h >> 32)) ^ std::hash<std::string_view>()(second);
+    }
+
+    std::string_view second(const Slot& slot) const {
+        return std::string_view(bytes_.data() + slot.secondBegin, slot.secondSize);
+    }
+
+    // slot da chave, ou o slot vazio onde ela entraria
+    size_t probe(int64_t first, std::string_view key, size_t h) const {
+        size_t mask = slots_.size() - 1;
+        size_t s = h & mask;
+        while (slots_[s].position != -1 &&
+               !(slots_[s].hash == h && slots_[s].first == first && second(slots_[s]) == key)) {
+            s = (s + 1) & mask;
+        }
+        return s;
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<char> bytes_;
+    std::vector<V> values_;
+};
@@ -12,6 +12,7 @@
 #include "loader.hpp"
 #include "threadPool.hpp"
 #include "queue.hpp"
+#include "arena.hpp"
 
 using Clock = std::chrono::high_resolution_clock;
 
@@ -95,19 +96,19 @@ void processParallelChunk(int numThreads, DataBase &db, const std::string &nomeA
     std::shared_ptr<const DataFrame<std::string>> users_df;
     std::shared_ptr<const DataFrame<std::string>> flight_seats_df;
     std::shared_ptr<const DataFrame<std::string>> flights_df;
-    std::unordered_map<std::string, std::string> userIdToCountry;
-    std::unordered_map<std::string, std::string> seatKeyToClass;
+    DimensionLookup<std::string> userIdToCountry;
+    CompositeLookup<std::string> seatKeyToClass;
     std::vector<DataFrame<std::string>> dfMeanPrices;
 
     Extractor extractor;
     users_df = std::make_shared<const DataFrame<std::string>>(
-        extractor.extractFromCsv("../generator/users.csv")
+        extractor.extractFromCsvParallel("../generator/users.csv", numThreads, {"user_id", "country"})
     );
     flight_seats_df = std::make_shared<const DataFrame<std::string>>(
-        extractor.extractFromCsv("../generator/flights_seats.csv")
+        extractor.extractFromCsvParallel("../generator/flights_seats.csv", numThreads, {"flight_id", "seat", "seat_class", "price"})
     );
     flights_df = std::make_shared<const DataFrame<std::string>>(
-        extractor.extractFromCsv("../generator/flights.csv")
+        extractor.extractFromCsvParallel("../generator/flights.csv", numThreads, {"flight_id", "from", "to", "airline"})
     );
 
     if (bfirstTime)
@@ -126,24 +127,31 @@ void processParallelChunk(int numThreads, DataBase &db, const std::string &nomeA
         dfMeanPrices[0].renameColumn("to", "destination");
     }
 
-    for (int i = 0; i < users_df->numRows(); ++i)
-            userIdToCountry[users_df->getValue("user_id", i)] = users_df->getValue("country", i);
-    
-    for (int i = 0; i < flight_seats_df->numRows(); ++i)
-        seatKeyToClass[flight_seats_df->getValue("flight_id", i) + "_" + flight_seats_df->getValue("seat", i)] =
-            flight_seats_df->getValue("seat_class", i);
+    // tabelas de dimensão: ids inteiros densos viram acesso direto a um vetor
+    userIdToCountry = DimensionLookup<std::string>::build(
+        users_df->values(users_df->column("user_id")), users_df->values(users_df->column("country")));
+    seatKeyToClass = CompositeLookup<std::string>::build(
+        flight_seats_df->values(flight_seats_df->column("flight_id")),
+        flight_seats_df->values(flight_seats_df->column("seat")),
+        flight_seats_df->values(flight_seats_df->column("seat_class")));
 
     // Create shared handlers
     auto sharedFlightEnricher = std::make_shared<FlightInfoEnricherHandler>(*flights_df);
-    auto sharedDestinationCounter = std::make_shared<DestinationCounterHandler>();
 
     ThreadPool pool(numThreads);
+    static ArenaPool batchArenas;  // reaproveitado entre chamadas (lotes do servidor)
     Queue<int, DataFrame<std::string>> partitionQueue(numThreads);
     Queue<int, DataFrame<std::string>> processedQueue(numThreads);
-    Queue<int, DataFrame<std::string>> userCountryQueue(numThreads);
-    Queue<int, DataFrame<std::string>> seatTypeQueue(numThreads);
     Queue<int, DataFrame<std::string>> flightStatsQueue(numThreads);
-    Queue<int, DataFrame<std::string>> destinationStatsQueue(numThreads);
+
+    // receita e reservas do lote por dia × pagamento × país × assento × destino; as partições
+    // montam cubos locais e juntam neste no fim
+    RollupCube batchCube;
+
+    // flight_id -> número do voo uma única vez; partições e enriquecedores reaproveitam as chaves
+    if (df.columnExists("flight_id")) {
+        df.surrogateKeys("flight_id");
+    }
 
     // Partition the data
     size_t chunk_size = df.numRows() / numThreads;
@@ -163,36 +171,37 @@ void processParallelChunk(int numThreads, DataBase &db, const std::string &nomeA
     DateHandler dateHandler;
     
     // Instâncias únicas thread-safe
-    auto sharedUserHandler = std::make_shared<UsersCountryRevenue>(userIdToCountry);
-    auto sharedSeatHandler = std::make_shared<SeatTypeRevenue>(seatKeyToClass);
+    auto sharedCubeHandler = std::make_shared<RollupCubeHandler>(userIdToCountry, seatKeyToClass);
 
     for (int i = 0; i < numThreads; ++i)
     {
-        processingFutures.push_back(pool.addTask([&, i, sharedUserHandler, sharedSeatHandler, sharedFlightEnricher, sharedDestinationCounter]()
+        processingFutures.push_back(pool.addTask([&, i, sharedCubeHandler, sharedFlightEnricher]()
         {
+            // temporários dos handlers vão para uma arena do pool, liberada de uma vez no fim da partição
+            ArenaPool::Lease arena = batchArenas.acquire();
+            ArenaScope arenaScope(*arena);
+
             auto [idx, chunk] = partitionQueue.deQueue();
-            auto processed = validationHandler.process(chunk);
-            processed = statusFilterHandler.process(processed);
+
+            // validação, filtro de status e data fundidos em uma única passada sobre a partição
+            LazyFrame<std::string> plan(std::move(chunk));
+            validationHandler.addToPlan(plan);
+            statusFilterHandler.addToPlan(plan);
+            dateHandler.addToPlan(plan);
+            DataFrame<std::string> processed = plan.collect();
 
             // Process flight enrichment
-            auto flightResults = sharedFlightEnricher->processMulti({processed});
-            DataFrame<std::string> enrichedDf = flightResults[0];
-            DataFrame<std::string> flightStats = flightResults[1];
-            
-            // Process destination stats
-            DataFrame<std::string> destinationStats = sharedDestinationCounter->process(enrichedDf);
-            
-            // Process other handlers
-            DataFrame<std::string> countryRevenue = sharedUserHandler->process(enrichedDf);
-            DataFrame<std::string> seatRevenue = sharedSeatHandler->process(enrichedDf);
-
-            userCountryQueue.enQueue({idx, countryRevenue});
-            seatTypeQueue.enQueue({idx, seatRevenue});
-            flightStatsQueue.enQueue({idx, flightStats});
-            destinationStatsQueue.enQueue({idx, destinationStats});
-
-            processed = dateHandler.process(enrichedDf);
-            processedQueue.enQueue({idx, processed});
+            auto flightResults = sharedFlightEnricher->enrich(std::move(processed));  // sem cópia da partição
+            DataFrame<std::string> enrichedDf = std::move(flightResults[0]);
+            DataFrame<std::string> flightStats = std::move(flightResults[1]);
+
+            // uma passada pela partição alimenta todas as tabelas de faturamento e de destinos
+            RollupCube partitionCube;
+            sharedCubeHandler->addTo(partitionCube, enrichedDf);
+            batchCube.merge(partitionCube);
+
+            flightStatsQueue.enQueue({idx, std::move(flightStats)});
+            processedQueue.enQueue({idx, std::move(enrichedDf)});
         }));
     }
 
@@ -205,23 +214,7 @@ void processParallelChunk(int numThreads, DataBase &db, const std::string &nomeA
     for (int i = 0; i < numThreads; ++i)
     {
         auto [idx, processed] = processedQueue.deQueue();
-        allProcessed = (i == 0) ? processed : allProcessed.concat(processed);
-    }
-
-    // Aggregate user country data
-    DataFrame<std::string> allUserCountry;
-    for (int i = 0; i < numThreads; ++i)
-    {
-        auto [idx, countryDf] = userCountryQueue.deQueue();
-        allUserCountry = (i == 0) ? countryDf : allUserCountry.concat(countryDf);
-    }
-
-    // Aggregate seat type data
-    DataFrame<std::string> allSeatType;
-    for (int i = 0; i < numThreads; ++i)
-    {
-        auto [idx, seatDf] = seatTypeQueue.deQueue();
-        allSeatType = (i == 0) ? seatDf : allSeatType.concat(seatDf);
+        allProcessed.append(std::move(processed));
     }
 
     // Aggregate flight stats
@@ -229,31 +222,18 @@ void processParallelChunk(int numThreads, DataBase &db, const std::string &nomeA
     for (int i = 0; i < numThreads; ++i)
     {
         auto [idx, flightDf] = flightStatsQueue.deQueue();
-        allFlightStats = (i == 0) ? flightDf : allFlightStats.concat(flightDf);
-    }
-
-    // Aggregate destination stats
-    DataFrame<std::string> allDestinationStats;
-    for (int i = 0; i < numThreads; ++i)
-    {
-        auto [idx, destDf] = destinationStatsQueue.deQueue();
-        allDestinationStats = (i == 0) ? destDf : allDestinationStats.concat(destDf);
+        allFlightStats.append(std::move(flightDf));
     }
 
     // Final aggregation phase
     auto startAggregation = Clock::now();
-    RevenueHandler revenueHandler;
-    CardRevenueHandler cardHandler;
-
-    DataFrame<std::string> revenue = revenueHandler.process(allProcessed);
-    DataFrame<std::string> cards = cardHandler.process(allProcessed);
-
-    auto aggregatedRevenue = revenue.groupby("reservation_time", "price");
-    auto aggregatedCards = cards.groupby("payment_method", "price");
+    // as tabelas de faturamento e destinos são rollups do cubo do lote (sem reler as reservas)
+    auto aggregatedRevenue = batchCube.rollup({CubeDimension::Day});
+    auto aggregatedCards = batchCube.rollup({CubeDimension::PaymentMethod});
+    auto aggregatedUserCountry = batchCube.rollup({CubeDimension::UserCountry});
+    auto aggregatedSeatType = batchCube.rollup({CubeDimension::SeatType});
+    auto aggregatedDestinationStats = batchCube.rollup({CubeDimension::Destination});
     auto aggregatedFlightStats = allFlightStats.groupby("flight_number", "reservation_count");
-    auto aggregatedDestinationStats = allDestinationStats.groupby("destination", "reservation_count");
-    auto aggregatedUserCountry = allUserCountry.groupby("user_country", "price");
-    auto aggregatedSeatType = allSeatType.groupby("seat_type", "price");
     auto endAggregation = Clock::now();
 
     // Load all data into DB
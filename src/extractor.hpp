@@ -5,10 +5,21 @@
 #include <iostream>
 #include "dataframe.hpp"
 #include "queue.hpp"
+#include "threadPool.hpp"
+#include "mappedFile.hpp"
+#include "csvParser.hpp"
+#include "stringColumn.hpp"
+#include "typedFrame.hpp"
+#include "predicate.hpp"
+#include "columnarFile.hpp"
 #include "event.pb.h"
 #include <sqlite3.h>
+#include <memory>
 #include <mutex>
 #include <random>
+#include <future>
+#include <cctype>
+#include <iterator>
 
 namespace events {
     class Event;  // Forward declaration
@@ -21,6 +32,165 @@ private:
     std::random_device rd;
     std::mt19937 gen;
 
+    // Structural scan over a JSON array of records. Returns the [begin, end) byte range of
+    // every top-level element, tracking only nesting depth and string/escape state.
+    static std::vector<std::pair<size_t, size_t>> scanJsonRecords(const char* data, size_t size) {
+        std::vector<std::pair<size_t, size_t>> records;
+
+        size_t pos = 0;
+        while (pos < size && std::isspace(static_cast<unsigned char>(data[pos]))) ++pos;
+        if (pos >= size || data[pos] != '[') {
+            throw std::runtime_error("JSON data should be an array of records");
+        }
+        ++pos;
+
+        int depth = 0;
+        size_t recordStart = std::string::npos;
+        bool afterComma = false;  // a comma must be followed by another element
+        for (; pos < size; ++pos) {
+            char c = data[pos];
+            if (c == '"') {
+                if (recordStart == std::string::npos) recordStart = pos;
+                // Skip the whole string, honoring escapes
+                for (++pos; pos < size && data[pos] != '"'; ++pos) {
+                    if (data[pos] == '\\') ++pos;
+                }
+                continue;
+            }
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                continue;
+            }
+            if (depth == 0 && (c == ',' || c == ']')) {
+                if (recordStart != std::string::npos) {
+                    size_t recordEnd = pos;
+                    while (std::isspace(static_cast<unsigned char>(data[recordEnd - 1]))) --recordEnd;
+                    records.emplace_back(recordStart, recordEnd);
+                    recordStart = std::string::npos;
+                } else if (c == ',' || afterComma) {
+                    throw std::runtime_error("Malformed JSON array: empty element");
+                }
+                afterComma = (c == ',');
+                if (c == ']') {
+                    // nothing but whitespace may follow the array
+                    for (++pos; pos < size; ++pos) {
+                        if (!std::isspace(static_cast<unsigned char>(data[pos]))) {
+                            throw std::runtime_error("Malformed JSON: data after the closing bracket");
+                        }
+                    }
+                    return records;
+                }
+                continue;
+            }
+            if (recordStart == std::string::npos) recordStart = pos;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                --depth;
+            }
+        }
+
+        throw std::runtime_error("Malformed JSON array: missing closing bracket");
+    }
+
+    // Maps each projected column name to its position in the header. An empty projection
+    // keeps every column, in file order.
+    static std::vector<size_t> resolveProjection(const std::vector<std::string>& header,
+                                                 const std::vector<std::string>& projection) {
+        std::vector<size_t> indices;
+        if (projection.empty()) {
+            for (size_t i = 0; i < header.size(); ++i) {
+                indices.push_back(i);
+            }
+            return indices;
+        }
+
+        for (const auto& column : projection) {
+            auto it = std::find(header.begin(), header.end(), column);
+            if (it == header.end()) {
+                throw std::invalid_argument("Column does not exist: " + column);
+            }
+            indices.push_back(static_cast<size_t>(it - header.begin()));
+        }
+        return indices;
+    }
+
+    // A predicate resolved to the position of its field in the source records
+    using BoundPredicate = std::pair<size_t, const ColumnPredicate*>;
+
+    static std::vector<BoundPredicate> bindPredicates(const std::vector<std::string>& header,
+                                                      const std::vector<ColumnPredicate>& predicates) {
+        std::vector<BoundPredicate> bound;
+        for (const auto& predicate : predicates) {
+            auto it = std::find(header.begin(), header.end(), predicate.column());
+            if (it == header.end()) {
+                throw std::invalid_argument("Column does not exist: " + predicate.column());
+            }
+            bound.emplace_back(static_cast<size_t>(it - header.begin()), &predicate);
+        }
+        return bound;
+    }
+
+    static bool recordMatches(const std::vector<std::string_view>& fields, const std::vector<BoundPredicate>& predicates) {
+        for (const auto& [index, predicate] : predicates) {
+            if (!predicate->matches(index < fields.size() ? fields[index] : std::string_view())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool recordMatches(const nlohmann::json& record, const std::vector<ColumnPredicate>& predicates) {
+        for (const auto& predicate : predicates) {
+            auto it = record.find(predicate.column());
+            if (!predicate.matches(it != record.end() ? toString(*it) : std::string())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Parses the CSV records in [begin, end) straight into one buffer per projected field,
+    // padding short rows with "". Fields after the last projected (or filtered) one are
+    // never split, and records rejected by a predicate are never materialized.
+    template <typename Column = std::vector<std::string>>
+    static std::vector<Column> parseCsvRange(CsvParser& parser, size_t begin, size_t end,
+                                             const std::vector<size_t>& fieldIndices,
+                                             const std::vector<BoundPredicate>& predicates = {}) {
+        std::vector<Column> columnData(fieldIndices.size());
+        size_t maxFields = 0;
+        for (size_t index : fieldIndices) {
+            maxFields = std::max(maxFields, index + 1);
+        }
+        for (const auto& predicate : predicates) {
+            maxFields = std::max(maxFields, predicate.first + 1);
+        }
+
+        std::vector<std::string_view> fields;
+        size_t pos = begin;
+        while (parser.nextRecord(pos, end, fields, maxFields)) {
+            if (!recordMatches(fields, predicates)) {
+                continue;
+            }
+            for (size_t i = 0; i < fieldIndices.size(); ++i) {
+                if (fieldIndices[i] < fields.size()) {
+                    columnData[i].emplace_back(fields[fieldIndices[i]]);
+                } else {
+                    columnData[i].emplace_back();
+                }
+            }
+        }
+        return columnData;
+    }
+
+    // append a JSON field to a column; absent fields (nullptr) and JSON nulls are stored as nulls
+    static void appendJsonValue(Series<std::string>& column, const nlohmann::json* value) {
+        if (value == nullptr || value->is_null()) {
+            column.addNull();
+        } else {
+            column.addElement(toString(*value));
+        }
+    }
+
 public:
     bool bDebugMode = true;
     
@@ -33,11 +203,11 @@ public:
     }
 
     // We're going to use to have no problems when dealing with the json
-    std::string toString(const nlohmann::json& jsonValue) {
+    static std::string toString(const nlohmann::json& jsonValue) {
         if (jsonValue.is_string()) {
             return jsonValue.get<std::string>(); 
         } else if (jsonValue.is_number()) {
-            return std::to_string(jsonValue.get<double>()); // For numbers 
+            return jsonValue.dump(); // For numbers: shortest round-trip text (123.45, not 123.450000)
         } else if (jsonValue.is_boolean()) {
             return jsonValue.get<bool>() ? "true" : "false"; // For booleans
         } else {
@@ -45,8 +215,9 @@ public:
         }
     }
 
-    // Extract an entire chunk
-    DataFrame<std::string> extractChunk(const std::string& filePath, const std::vector<std::string>& columns, size_t chunk_size = 0) {
+    // Extract an entire chunk (records rejected by a predicate are skipped but still consumed)
+    DataFrame<std::string> extractChunk(const std::string& filePath, const std::vector<std::string>& columns, size_t chunk_size = 0,
+                                        const std::vector<ColumnPredicate>& predicates = {}) {
         std::lock_guard<std::mutex> lock(position_mutex);
         size_t& current_pos = file_positions[filePath];
 
@@ -71,33 +242,24 @@ public:
             // Process either specified chunk or remaining lines
             size_t end_pos = (chunk_size == 0) ? total_records : std::min(current_pos + chunk_size, total_records);
 
-            std::unordered_map<std::string, std::vector<std::string>> extracted_data;
-            for (const auto& col : columns) {
-                extracted_data[col] = std::vector<std::string>();  // Initialize empty vectors for each column
-            }
+            std::vector<Series<std::string>> series(columns.size());
 
             for (size_t i = current_pos; i < end_pos; ++i) {
                 const auto& record = jsonData[i];
+                if (!recordMatches(record, predicates)) {
+                    continue;
+                }
 
-                for (const auto& col : columns) {
-                    // Assure that the value will be treated as a string
-                    if (record.contains(col)) {
-                        extracted_data[col].push_back(toString(record[col]));
-                    } else {
-                        extracted_data[col].push_back("");  // Handle missing values
-                    }
+                for (size_t c = 0; c < columns.size(); ++c) {
+                    // Missing fields and JSON nulls become nulls in the column
+                    auto it = record.find(columns[c]);
+                    appendJsonValue(series[c], it != record.end() ? &*it : nullptr);
                 }
             }
 
             current_pos = end_pos; // Update position
 
-            // Create series for each column
-            std::vector<Series<std::string>> series;
-            for (const auto& col : columns) {
-                series.push_back(Series<std::string>(extracted_data[col]));
-            }
-
-            return DataFrame<std::string>(columns, series);
+            return DataFrame<std::string>(columns, std::move(series));
         } catch (const std::exception& e) {
             std::cerr << "Extraction error: " << e.what() << std::endl;
             throw;
@@ -136,32 +298,21 @@ public:
                 size_t thread_start = current_pos + (i * per_thread);
                 size_t thread_end = (i == numThreads - 1) ? end_pos : thread_start + per_thread;
 
-                std::unordered_map<std::string, std::vector<std::string>> extracted_data;
-                for (const auto& col : columns) {
-                    extracted_data[col] = std::vector<std::string>();  // Initialize empty vectors for each column
-                }
+                std::vector<Series<std::string>> series(columns.size());
 
                 // Iterate over the chunk assigned to the current thread
                 for (size_t j = thread_start; j < thread_end; ++j) {
                     const auto& record = jsonData[j];
 
-                    for (const auto& col : columns) {
-                        if (record.contains(col)) {
-                            extracted_data[col].push_back(toString(record[col]));  // Using toString to handle any type safely
-                        } else {
-                            extracted_data[col].push_back("");  // Handle missing values as empty strings
-                        }
+                    // Missing fields and JSON nulls become nulls in the column
+                    for (size_t c = 0; c < columns.size(); ++c) {
+                        auto it = record.find(columns[c]);
+                        appendJsonValue(series[c], it != record.end() ? &*it : nullptr);
                     }
                 }
 
-                // Create the DataFrame for the partition
-                std::vector<Series<std::string>> series;
-                for (const auto& col : columns) {
-                    series.push_back(Series<std::string>(extracted_data[col]));
-                }
-
                 // Enqueue the partitioned DataFrame
-                partitionQueue.enQueue({i, DataFrame<std::string>(columns, series)});
+                partitionQueue.enQueue({i, DataFrame<std::string>(columns, std::move(series))});
             }
 
             current_pos = end_pos; // Update position
@@ -179,48 +330,55 @@ public:
     }
 
     // Extract from a TXT file (ig its fine)
-    DataFrame<std::string> extractFromTxt(const std::string& filePath, const std::vector<std::string>& columns, char delimiter = '\t') {
+    // columns names the fields by position; projection picks which of them to keep.
+    DataFrame<std::string> extractFromTxt(const std::string& filePath, const std::vector<std::string>& columns, char delimiter = '\t',
+                                          const std::vector<std::string>& projection = {}) {
         try {
             std::ifstream file(filePath);
             if (!file.is_open()) {
                 throw std::runtime_error("Could not open the file: " + filePath);
             }
 
+            std::vector<size_t> fieldIndices = resolveProjection(columns, projection);
+            size_t maxFields = 0;
+            for (size_t index : fieldIndices) {
+                maxFields = std::max(maxFields, index + 1);
+            }
+
             std::string line;
-            std::vector<std::vector<std::string>> data;
+            std::vector<std::vector<std::string>> columnData(fieldIndices.size());
+            std::vector<std::string> row;
 
             // Read every line in the file
             while (std::getline(file, line)) {
-                std::vector<std::string> row;
+                row.clear();
                 std::stringstream ss(line);
                 std::string cell;
 
-                // Will use the delimiter char to be able to distinguish things
-                while (std::getline(ss, cell, delimiter)) {
+                // Will use the delimiter char to be able to distinguish things (only up to the last projected field)
+                while (row.size() < maxFields && std::getline(ss, cell, delimiter)) {
                     row.push_back(cell);
                 }
 
-                data.push_back(row);  // Add the line
+                for (size_t i = 0; i < fieldIndices.size(); ++i) {
+                    if (fieldIndices[i] < row.size()) {
+                        columnData[i].push_back(std::move(row[fieldIndices[i]]));
+                    } else {
+                        columnData[i].push_back("");
+                    }
+                }
             }
 
             file.close();
 
             // We create the series we need for the DF
             std::vector<Series<std::string>> series;
-            for (size_t i = 0; i < columns.size(); ++i) {
-                std::vector<std::string> columnData;
-                for (const auto& row : data) {
-                    if (i < row.size()) {
-                        columnData.push_back(row[i]);
-                    } else {
-                        columnData.push_back("");
-                    }
-                }
-                series.push_back(Series<std::string>(columnData));
+            for (auto& data : columnData) {
+                series.push_back(Series<std::string>(std::move(data)));
             }
 
             // Add the columns together
-            return DataFrame<std::string>(columns, series);
+            return DataFrame<std::string>(projection.empty() ? columns : projection, std::move(series));
 
         } catch (const std::exception& e) {
             std::cerr << "TXT extraction error: " << e.what() << std::endl;
@@ -228,122 +386,346 @@ public:
         }
     }
 
-    // Extract from a CSV file (the same as before but easier actually)
-    DataFrame<std::string> extractFromCsv(const std::string& filePath) {
+    // Extract from a CSV file (RFC 4180 quoting). The file is memory-mapped and every field
+    // is written straight into its column buffer; short rows are padded with "".
+    // Only the columns in projection are materialized (all of them when it is empty), and
+    // only the records accepted by every predicate.
+    DataFrame<std::string> extractFromCsv(const std::string& filePath, const std::vector<std::string>& projection = {},
+                                          const std::vector<ColumnPredicate>& predicates = {}) {
         try {
-            std::ifstream file(filePath);
-            if (!file.is_open()) {
-                throw std::runtime_error("Could not open the file: " + filePath);
+            MappedFile file(filePath);
+            CsvParser parser(file.data(), file.size());
+
+            size_t pos = parser.begin();
+            std::vector<std::string_view> fields;
+
+            // Read columns (first line)
+            std::vector<std::string> columns;
+            if (parser.nextRecord(pos, parser.size(), fields)) {
+                for (const auto& field : fields) {
+                    columns.emplace_back(field);
+                }
             }
 
-            std::string line;
+            if (columns.empty()) {
+                return DataFrame<std::string>();
+            }
+
+            std::vector<size_t> fieldIndices = resolveProjection(columns, projection);
+            std::vector<BoundPredicate> boundPredicates = bindPredicates(columns, predicates);
+            if (!projection.empty()) {
+                columns = projection;
+            }
+
+            // Read rows directly into the column buffers
+            std::vector<std::vector<std::string>> columnData = parseCsvRange(parser, pos, parser.size(), fieldIndices, boundPredicates);
+
+            // Prepare DataFrame
+            std::vector<Series<std::string>> series;
+            for (auto& data : columnData) {
+                series.push_back(Series<std::string>(std::move(data)));
+            }
+
+            return DataFrame<std::string>(columns, std::move(series));
+        } catch (const std::exception& e) {
+            std::cerr << "CSV extraction error: " << e.what() << std::endl;
+            throw;
+        }
+    } 
+
+    // Same as extractFromCsv, but the values land in contiguous StringColumns (one byte
+    // buffer + offsets per column) instead of one std::string per cell. Meant for scans
+    // and aggregations that only read the values as string_views.
+    std::vector<std::pair<std::string, StringColumn>> extractStringColumnsFromCsv(
+            const std::string& filePath, const std::vector<std::string>& projection = {},
+            const std::vector<ColumnPredicate>& predicates = {}) {
+        try {
+            MappedFile file(filePath);
+            CsvParser parser(file.data(), file.size());
+
+            size_t pos = parser.begin();
+            std::vector<std::string_view> fields;
+
             std::vector<std::string> columns;
-            std::vector<std::vector<std::string>> data;
+            if (parser.nextRecord(pos, parser.size(), fields)) {
+                for (const auto& field : fields) {
+                    columns.emplace_back(field);
+                }
+            }
 
-            // Read columns (first line)
-            std::getline(file, line);
-            std::stringstream ss(line);
-            std::string column;
-            while (std::getline(ss, column, ',')) {
-                columns.push_back(column);
+            std::vector<std::pair<std::string, StringColumn>> result;
+            if (columns.empty()) {
+                return result;
             }
 
-            // Read rows
-            while (std::getline(file, line)) {
-                std::stringstream rowStream(line);
-                std::vector<std::string> row;
-                while (std::getline(rowStream, column, ',')) {
-                    row.push_back(column);
+            std::vector<size_t> fieldIndices = resolveProjection(columns, projection);
+            std::vector<BoundPredicate> boundPredicates = bindPredicates(columns, predicates);
+            if (!projection.empty()) {
+                columns = projection;
+            }
+
+            std::vector<StringColumn> columnData =
+                parseCsvRange<StringColumn>(parser, pos, parser.size(), fieldIndices, boundPredicates);
+            for (size_t c = 0; c < columns.size(); ++c) {
+                result.emplace_back(columns[c], std::move(columnData[c]));
+            }
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "CSV extraction error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    // Parallel CSV loading: the mapped file is cut into numThreads byte ranges, each range is
+    // moved forward to the next record boundary (quote parity per range is counted in parallel
+    // first, so quoted line breaks never split a record), and every ThreadPool worker parses
+    // its own range. The partitions are stitched by moving their strings into the result.
+    DataFrame<std::string> extractFromCsvParallel(const std::string& filePath, int numThreads,
+                                                  const std::vector<std::string>& projection = {},
+                                                  const std::vector<ColumnPredicate>& predicates = {}) {
+        try {
+            if (numThreads < 1) {
+                throw std::invalid_argument("numThreads must be at least 1");
+            }
+
+            MappedFile file(filePath);
+            CsvParser parser(file.data(), file.size());
+
+            size_t pos = parser.begin();
+            std::vector<std::string_view> fields;
+
+            // Read columns (first line)
+            std::vector<std::string> columns;
+            if (parser.nextRecord(pos, parser.size(), fields)) {
+                for (const auto& field : fields) {
+                    columns.emplace_back(field);
                 }
-                data.push_back(row);
             }
 
-            // Prepare DataFrame
+            if (columns.empty()) {
+                return DataFrame<std::string>();
+            }
+
+            std::vector<size_t> fieldIndices = resolveProjection(columns, projection);
+            std::vector<BoundPredicate> boundPredicates = bindPredicates(columns, predicates);
+            if (!projection.empty()) {
+                columns = projection;
+            }
+
+            const size_t dataStart = pos;
+            const size_t dataSize = parser.size() - dataStart;
+            const size_t rangeSize = dataSize / numThreads;
+
+            ThreadPool pool(numThreads);
+
+            // Run the parser's field state machine over every raw byte range, from every
+            // possible start state, to learn the exact state at each cut
+            std::vector<size_t> cuts(numThreads + 1);
+            for (int i = 0; i < numThreads; ++i) {
+                cuts[i] = dataStart + i * rangeSize;
+            }
+            cuts[numThreads] = parser.size();
+
+            std::vector<std::future<CsvParser::ScanTransitions>> scanFutures;
+            for (int i = 0; i < numThreads - 1; ++i) {
+                scanFutures.push_back(pool.addTask([&parser, &cuts, i]() {
+                    return parser.scanTransitions(cuts[i], cuts[i + 1]);
+                }));
+            }
+
+            // Align every cut to the start of the next record
+            std::vector<size_t> starts(numThreads + 1);
+            starts[0] = dataStart;
+            starts[numThreads] = parser.size();
+            CsvParser::ScanState state = CsvParser::ScanState::LineStart;  // the header ended a line
+            for (int i = 1; i < numThreads; ++i) {
+                state = scanFutures[i - 1].get()[static_cast<size_t>(state)];
+                size_t aligned = parser.nextRecordStart(cuts[i], state);
+                starts[i] = std::max(aligned, starts[i - 1]);
+            }
+
+            // Each worker parses its own range with its own parser state
+            std::vector<std::future<std::vector<std::vector<std::string>>>> parseFutures;
+            for (int i = 0; i < numThreads; ++i) {
+                parseFutures.push_back(pool.addTask([&file, &starts, &fieldIndices, &boundPredicates, i]() {
+                    CsvParser rangeParser(file.data(), file.size());
+                    return parseCsvRange(rangeParser, starts[i], starts[i + 1], fieldIndices, boundPredicates);
+                }));
+            }
+
+            std::vector<std::vector<std::vector<std::string>>> partitions;
+            for (auto& fut : parseFutures) {
+                partitions.push_back(fut.get());
+            }
+
+            // Stitch the partitions column by column, moving the strings
             std::vector<Series<std::string>> series;
-            for (size_t i = 0; i < columns.size(); ++i) {
+            for (size_t c = 0; c < columns.size(); ++c) {
+                size_t total = 0;
+                for (const auto& partition : partitions) {
+                    total += partition[c].size();
+                }
+
                 std::vector<std::string> columnData;
-                for (const auto& row : data) {
-                    columnData.push_back(row[i]);
+                columnData.reserve(total);
+                for (auto& partition : partitions) {
+                    std::move(partition[c].begin(), partition[c].end(), std::back_inserter(columnData));
+                    partition[c] = std::vector<std::string>();
                 }
-                series.push_back(Series<std::string>(columnData));
+                series.push_back(Series<std::string>(std::move(columnData)));
             }
 
-            return DataFrame<std::string>(columns, series);
+            return DataFrame<std::string>(columns, std::move(series));
         } catch (const std::exception& e) {
             std::cerr << "CSV extraction error: " << e.what() << std::endl;
             throw;
         }
-    } 
+    }
+
+    // Column names of a SQLite table (empty if the table does not exist)
+    static std::vector<std::string> sqliteTableColumns(sqlite3* db, const std::string& tableName) {
+        std::vector<std::string> names;
+        sqlite3_stmt* rawStmt = nullptr;
+        std::string query = "PRAGMA table_info(" + ColumnPredicate::quoteIdentifier(tableName) + ")";
+        int rc = sqlite3_prepare_v2(db, query.c_str(), -1, &rawStmt, 0);
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> stmt(rawStmt, &sqlite3_finalize);
+        if (rc != SQLITE_OK) {
+            throw std::runtime_error("Failed to read the table schema: " + std::string(sqlite3_errmsg(db)));
+        }
+        while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+            const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 1));
+            names.push_back(name ? name : "");
+        }
+        return names;
+    }
 
     // Extract from a SQLite database
-    DataFrame<std::string> extractFromSqlite(const std::string& dbPath, const std::string& tableName) {
+    // The projection is pushed into the generated SELECT (all columns when it is empty) and
+    // the text predicates into its WHERE clause, with the values bound as parameters.
+    // Predicates with a numeric value are checked with ColumnPredicate::matches() on each
+    // fetched row instead: matches() compares numerically whenever the field is a number,
+    // which SQLite does not do for a TEXT column.
+    DataFrame<std::string> extractFromSqlite(const std::string& dbPath, const std::string& tableName,
+                                             const std::vector<std::string>& projection = {},
+                                             const std::vector<ColumnPredicate>& predicates = {}) {
         try {
-            sqlite3* db;
-            int rc = sqlite3_open(dbPath.c_str(), &db);
+            // the handles are released on every exit path, including exceptions
+            sqlite3* rawDb = nullptr;
+            int rc = sqlite3_open(dbPath.c_str(), &rawDb);
+            std::unique_ptr<sqlite3, decltype(&sqlite3_close)> db(rawDb, &sqlite3_close);
 
             if (rc) {
-                throw std::runtime_error("Cannot open database: " + std::string(sqlite3_errmsg(db)));
+                throw std::runtime_error("Cannot open database: " + std::string(sqlite3_errmsg(db.get())));
+            }
+
+            // Identifiers are checked against the table schema and quoted: SQLite would read an
+            // unknown double-quoted name as a string literal instead of failing
+            std::vector<std::string> tableColumns = sqliteTableColumns(db.get(), tableName);
+            if (tableColumns.empty()) {
+                throw std::invalid_argument("Table does not exist: " + tableName);
+            }
+            auto checkColumn = [&](const std::string& name) {
+                if (std::find(tableColumns.begin(), tableColumns.end(), name) == tableColumns.end()) {
+                    throw std::invalid_argument("Column does not exist: " + name);
+                }
+            };
+            for (const auto& name : projection) checkColumn(name);
+            for (const auto& predicate : predicates) checkColumn(predicate.column());
+
+            std::vector<const ColumnPredicate*> pushed;
+            std::vector<BoundPredicate> residual;  // index into the fetched columns
+            std::vector<std::string> fetched = projection.empty() ? tableColumns : projection;
+            const size_t outputCount = fetched.size();
+            for (const auto& predicate : predicates) {
+                if (!predicate.hasSqlParameter() || !predicate.valueIsNumeric()) {
+                    pushed.push_back(&predicate);
+                    continue;
+                }
+                // fetched only for the check when it is not projected
+                auto it = std::find(fetched.begin(), fetched.end(), predicate.column());
+                if (it == fetched.end()) {
+                    it = fetched.insert(fetched.end(), predicate.column());
+                }
+                residual.emplace_back(static_cast<size_t>(it - fetched.begin()), &predicate);
             }
 
             // Get the query with the items from the table we want
-            sqlite3_stmt* stmt;
-            std::string query = ("SELECT * FROM " + tableName);
-            rc = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, 0);
+            std::string selectList;
+            for (size_t i = 0; i < fetched.size(); ++i) {
+                selectList += (i > 0 ? ", " : "") + ColumnPredicate::quoteIdentifier(fetched[i]);
+            }
+
+            std::string whereClause;
+            for (size_t i = 0; i < pushed.size(); ++i) {
+                whereClause += (i == 0 ? " WHERE " : " AND ") + pushed[i]->toSql();
+            }
+
+            sqlite3_stmt* rawStmt = nullptr;
+            std::string query = ("SELECT " + selectList + " FROM " + ColumnPredicate::quoteIdentifier(tableName) + whereClause);
+            rc = sqlite3_prepare_v2(db.get(), query.c_str(), -1, &rawStmt, 0);
+            std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> stmt(rawStmt, &sqlite3_finalize);
             if (rc != SQLITE_OK) {
-                throw std::runtime_error("Failed to execute query: " + std::string(sqlite3_errmsg(db)));
+                throw std::runtime_error("Failed to execute query: " + std::string(sqlite3_errmsg(db.get())));
+            }
+
+            // The pushed values are text, compared as strings like matches() does for them
+            int param = 1;
+            for (const ColumnPredicate* predicate : pushed) {
+                if (!predicate->hasSqlParameter()) {
+                    continue;
+                }
+                sqlite3_bind_text(stmt.get(), param++, predicate->value().c_str(), -1, SQLITE_TRANSIENT);
             }
 
             std::vector<std::string> columns_from_db; // To store column names retrieved from DB
-            std::vector<std::vector<std::string>> data;
+            std::vector<bool> isTimestamp;
 
-            // Get column names
-            int columnCount = sqlite3_column_count(stmt);
+            // Get column names (the columns fetched only for a residual check are not returned)
+            int columnCount = static_cast<int>(outputCount);
             for (int i = 0; i < columnCount; ++i) {
-                columns_from_db.push_back(sqlite3_column_name(stmt, i));
+                columns_from_db.push_back(sqlite3_column_name(stmt.get(), i));
+                isTimestamp.push_back(columns_from_db.back() == "timestamp");
             }
 
-            // Get rows of data
-            while (sqlite3_step(stmt) == SQLITE_ROW) {
-                std::vector<std::string> row;
+            // Get rows of data straight into the column series
+            std::vector<Series<std::string>> series(columnCount);
+            while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+                bool accepted = true;
+                for (const auto& [index, predicate] : residual) {
+                    // a NULL field is checked as empty text, as in the columnar reader
+                    const char* val = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), static_cast<int>(index)));
+                    if (!predicate->matches(val ? std::string_view(val) : std::string_view())) {
+                        accepted = false;
+                        break;
+                    }
+                }
+                if (!accepted) {
+                    continue;
+                }
                 for (int i = 0; i < columnCount; ++i) {
-                    // Get column name for type-specific extraction
-                    std::string colName = sqlite3_column_name(stmt, i);
-                    
-                    // Check if the column value is NULL
-                    if (sqlite3_column_type(stmt, i) == SQLITE_NULL) {
-                        row.push_back(""); // Replace NULL with empty string
-                    } else {
+                    // SQL NULL stays a null in the column (validity bit cleared)
+                    if (sqlite3_column_type(stmt.get(), i) == SQLITE_NULL) {
+                        series[i].addNull();
+                    } else if (isTimestamp[i]) {
                         // Special handling for timestamp, which is INTEGER
-                        if (colName == "timestamp") {
-                            long long timestamp_val = sqlite3_column_int64(stmt, i);
-                            row.push_back(std::to_string(timestamp_val));
-                        } else {
-                            const char* val = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
-                            row.push_back(val ? val : ""); // Handle non-NULL string values
-                        }
+                        long long timestamp_val = sqlite3_column_int64(stmt.get(), i);
+                        series[i].addElement(std::to_string(timestamp_val));
+                    } else {
+                        const char* val = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), i));
+                        series[i].addElement(std::string(val ? val : "")); // Handle non-NULL string values
                     }
                 }
-                data.push_back(row);
             }
 
             // char* errMsg;
             // query = ("DELETE FROM " + tableName + ";"); // This deletes all data from the table
             // rc = sqlite3_exec(db, query.c_str(), nullptr, nullptr, &errMsg); // COMMENTED OUT
 
-            sqlite3_finalize(stmt);
-            sqlite3_close(db);
+            stmt.reset();
+            db.reset();
 
             // Prepare the DataFrame
-            std::vector<Series<std::string>> series;
-            for (size_t i = 0; i < columns_from_db.size(); ++i) {
-                std::vector<std::string> columnData;
-                for (const auto& row : data) {
-                    columnData.push_back(row[i]);
-                }
-                series.push_back(Series<std::string>(columnData));
-            }
-
-            DataFrame<std::string> resultDf = DataFrame<std::string>(columns_from_db, series);
+            DataFrame<std::string> resultDf = DataFrame<std::string>(columns_from_db, std::move(series));
 
             return resultDf;
         } catch (const std::exception& e) {
@@ -352,59 +734,82 @@ public:
         }
     }
 
+    // Extract from a framework-native columnar file (see columnarFile.hpp). Only the
+    // projected columns are read from the mapped file, and chunks whose min/max stats
+    // rule out a predicate (e.g. a reservation_time window) are skipped entirely.
+    DataFrame<std::string> extractFromColumnar(const std::string& filePath, const std::vector<std::string>& projection = {},
+                                               const std::vector<ColumnPredicate>& predicates = {}) {
+        try {
+            columnar::ColumnarReader reader(filePath);
+            return reader.scan(projection, predicates);
+        } catch (const std::exception& e) {
+            std::cerr << "Columnar extraction error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    // Two-phase parallel JSON loader: the file is memory-mapped, a structural scan finds
+    // where each record of the top-level array starts and ends, and every ThreadPool worker
+    // parses only its own range of records straight into a partition DataFrame.
     void extractFromJsonPartitioned(const std::string& filePath, int numThreads, 
-        Queue<int, DataFrame<std::string>>& partitionQueue, const std::vector<std::string>& columns) {
+        Queue<int, DataFrame<std::string>>& partitionQueue, const std::vector<std::string>& columns,
+        const std::vector<ColumnPredicate>& predicates = {}) {
     
         try {
-            std::ifstream file(filePath);
-            if (!file.is_open()) {
-                throw std::runtime_error("Could not open the file: " + filePath);
+            if (numThreads < 1) {
+                throw std::invalid_argument("numThreads must be at least 1");
             }
-    
-            nlohmann::json jsonData;
-            file >> jsonData;
-    
-            if (!jsonData.is_array()) {
-                throw std::runtime_error("JSON data should be an array of records");
-            }
-    
-            size_t totalRecords = jsonData.size();
+
+            MappedFile file(filePath);
+
+            // Phase 1: find record boundaries without building the DOM
+            std::vector<std::pair<size_t, size_t>> records = scanJsonRecords(file.data(), file.size());
+
+            size_t totalRecords = records.size();
             size_t recordsPerPartition = totalRecords / numThreads;
-    
+
+            // Phase 2: each worker parses its range of records into its own partition. Nothing
+            // is enqueued until every record has parsed, so a malformed record loads nothing.
+            std::vector<DataFrame<std::string>> partitions(numThreads);
+            ThreadPool pool(numThreads);
+            std::vector<std::future<void>> futures;
             for (int i = 0; i < numThreads; ++i) {
                 size_t startIdx = i * recordsPerPartition;
                 size_t endIdx = (i == numThreads - 1) ? totalRecords : (i + 1) * recordsPerPartition;
-    
-                // Map to store column data
-                std::unordered_map<std::string, std::vector<std::string>> extracted_data;
-    
-                // Initialize vectors for each column
-                for (const auto& col : columns) {
-                    extracted_data[col] = std::vector<std::string>();
-                }
-    
-                // Process the chunk of records assigned to this thread
-                for (size_t j = startIdx; j < endIdx; ++j) {
-                    const auto& record = jsonData[j];
-    
-                    // For each column in the DataFrame, convert the JSON value to a string
-                    for (const auto& col : columns) {
-                        if (record.contains(col)) {
-                            extracted_data[col].push_back(toString(record[col]));  // Convert to string
-                        } else {
-                            extracted_data[col].push_back("");  // If column is missing, use an empty string
+
+                futures.push_back(pool.addTask([&, i, startIdx, endIdx]() {
+                    std::vector<Series<std::string>> series(columns.size());
+                    for (auto& column : series) {
+                        column.reserve(endIdx - startIdx);
+                    }
+
+                    for (size_t j = startIdx; j < endIdx; ++j) {
+                        const char* begin = file.data() + records[j].first;
+                        const char* end = file.data() + records[j].second;
+                        nlohmann::json record = nlohmann::json::parse(begin, end);
+                        if (!recordMatches(record, predicates)) {
+                            continue;
+                        }
+
+                        // For each column in the DataFrame, convert the JSON value to a string
+                        // (missing fields and JSON nulls become nulls)
+                        for (size_t c = 0; c < columns.size(); ++c) {
+                            auto it = record.find(columns[c]);
+                            appendJsonValue(series[c], it != record.end() ? &*it : nullptr);
                         }
                     }
-                }
-    
-                // Create the DataFrame for the partition
-                std::vector<Series<std::string>> series;
-                for (const auto& col : columns) {
-                    series.push_back(Series<std::string>(extracted_data[col]));
-                }
-    
-                // Enqueue the partitioned DataFrame
-                partitionQueue.enQueue({i, DataFrame<std::string>(columns, series)});
+
+                    partitions[i] = DataFrame<std::string>(columns, std::move(series));
+                }));
+            }
+
+            for (auto& fut : futures) {
+                fut.get();
+            }
+
+            // Enqueue the partitioned DataFrames
+            for (int i = 0; i < numThreads; ++i) {
+                partitionQueue.enQueue({i, std::move(partitions[i])});
             }
     
         } catch (const std::exception& e) {
@@ -413,26 +818,41 @@ public:
         }
     }
 
-    DataFrame<std::string> extractFromGrpcEvent(const events::Event* event) {
-        std::vector<std::string> columns = {
-            "flight_id", "seat", "user_id", "customer_name",
-            "status", "payment_method", "reservation_time", 
-            "price", "timestamp"
-        };
+    // Columns are emitted in the order of the projection (all nine when it is empty).
+    DataFrame<std::string> extractFromGrpcEvent(const events::Event* event, const std::vector<std::string>& projection = {}) {
+        static const std::vector<std::string> columns = ReservationFrame::columnNames();
+
+        std::vector<size_t> fieldIndices = resolveProjection(columns, projection);
 
         std::vector<Series<std::string>> series;
-        series.reserve(columns.size());  
+        series.reserve(fieldIndices.size());  
         
-        series.emplace_back(std::vector<std::string>{event->flight_id()});
-        series.emplace_back(std::vector<std::string>{event->seat()});
-        series.emplace_back(std::vector<std::string>{event->user_id()});
-        series.emplace_back(std::vector<std::string>{event->customer_name()});
-        series.emplace_back(std::vector<std::string>{event->status()});
-        series.emplace_back(std::vector<std::string>{event->payment_method()});
-        series.emplace_back(std::vector<std::string>{event->reservation_time()});
-        series.emplace_back(std::vector<std::string>{event->price()});
-        series.emplace_back(std::vector<std::string>{std::to_string(event->timestamp())});
-
-        return DataFrame<std::string>(columns, series);
+        for (size_t index : fieldIndices) {
+            switch (index) {
+                case 0: series.emplace_back(std::vector<std::string>{event->flight_id()}); break;
+                case 1: series.emplace_back(std::vector<std::string>{event->seat()}); break;
+                case 2: series.emplace_back(std::vector<std::string>{event->user_id()}); break;
+                case 3: series.emplace_back(std::vector<std::string>{event->customer_name()}); break;
+                case 4: series.emplace_back(std::vector<std::string>{event->status()}); break;
+                case 5: series.emplace_back(std::vector<std::string>{event->payment_method()}); break;
+                case 6: series.emplace_back(std::vector<std::string>{event->reservation_time()}); break;
+                case 7: series.emplace_back(std::vector<std::string>{event->price()}); break;
+                case 8: series.emplace_back(std::vector<std::string>{std::to_string(event->timestamp())}); break;
+            }
+        }
+
+        return DataFrame<std::string>(projection.empty() ? columns : projection, std::move(series));
+    }
+
+    // Typed variant: the event becomes one row of a ReservationFrame, with price and
+    // timestamp already numeric. A price that is not a number throws std::invalid_argument.
+    ReservationFrame extractReservationFromGrpcEvent(const events::Event* event) {
+        ReservationFrame frame;
+        double price;
+        typed_detail::parseValue(event->price(), price);
+        frame.addRow(event->flight_id(), event->seat(), event->user_id(), event->customer_name(),
+                     event->status(), event->payment_method(), event->reservation_time(),
+                     price, event->timestamp());
+        return frame;
     }
 };
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include "predicate.hpp"
+#include "bitmap.hpp"
+
+// Expressão de filtro sobre colunas de um DataFrame: comparações coluna/valor combinadas
+// com && e ||. Ex.: FilterExpr<T>::where("price", ">", "100") && FilterExpr<T>::where("status", "==", "confirmed")
+template <typename T>
+class FilterExpr {
+public:
+    using Op = ColumnPredicate::Op;
+    enum class Kind { Compare, And, Or };
+
+    static FilterExpr where(const std::string& column, Op op, const T& value = T()) {
+        FilterExpr expr(Kind::Compare);
+        expr.column_ = column;
+        expr.op_ = op;
+        expr.value_ = value;
+        return expr;
+    }
+
+    static FilterExpr where(const std::string& column, const std::string& condition, const T& value) {
+        return where(column, ColumnPredicate::parseOp(condition), value);
+    }
+
+    FilterExpr operator&&(const FilterExpr& other) const { return combine(Kind::And, other); }
+    FilterExpr operator||(const FilterExpr& other) const { return combine(Kind::Or, other); }
+
+    Kind kind() const { return kind_; }
+    const std::string& column() const { return column_; }
+    Op op() const { return op_; }
+    const T& value() const { return value_; }
+    const std::vector<FilterExpr>& children() const { return children_; }
+
+private:
+    explicit FilterExpr(Kind kind) : kind_(kind) {}
+
+    // a && b && c vira um único nó And com três filhos
+    FilterExpr combine(Kind kind, const FilterExpr& other) const {
+        FilterExpr result(kind);
+        for (const FilterExpr* side : {this, &other}) {
+            if (side->kind_ == kind) {
+                result.children_.insert(result.children_.end(), side->children_.begin(), side->children_.end());
+            } else {
+                result.children_.push_back(*side);
+            }
+        }
+        return result;
+    }
+
+    Kind kind_;
+    std::string column_;
+    Op op_ = Op::Equal;
+    T value_ = T();
+    std::vector<FilterExpr> children_;
+};
+
+// FilterExpr "compilado": nomes de coluna viram índices e a árvore vira um programa em
+// notação pós-fixa. A avaliação percorre as linhas uma única vez, em blocos de kBlockRows:
+// cada comparação roda como um laço apertado sobre o bloco (o operador é escolhido uma vez
+// por bloco, não por linha), os resultados são combinados com AND/OR byte a byte e o bloco
+// final é compactado no Bitmap de saída.
+template <typename T>
+class CompiledFilter {
+public:
+    using Op = ColumnPredicate::Op;
+    static constexpr size_t kBlockRows = 1024;
+
+    CompiledFilter(const FilterExpr<T>& expr, const std::vector<std::string>& columns) {
+        size_t depth = 0;
+        compile(expr, columns, depth);
+    }
+
+    // columnData[j] aponta para os valores da coluna j (na ordem de columns); retorna a
+    // máscara das linhas que satisfazem a expressão
+    Bitmap evaluate(const std::vector<const T*>& columnData, size_t rows) const {
+        Bitmap mask(rows);
+        std::vector<uint8_t> stack(maxDepth_ * kBlockRows);
+
+        for (size_t begin = 0; begin < rows; begin += kBlockRows) {
+            size_t n = std::min(kBlockRows, rows - begin);
+            size_t top = 0;
+            for (const Instruction& ins : program_) {
+                if (ins.code == Code::Compare) {
+                    compare(ins, columnData[ins.column] + begin, n, &stack[top * kBlockRows]);
+                    ++top;
+                    continue;
+                }
+                uint8_t* dst = &stack[(top - ins.arity) * kBlockRows];
+                for (size_t k = 1; k < ins.arity; ++k) {
+                    const uint8_t* src = &stack[(top - ins.arity + k) * kBlockRows];
+                    if (ins.code == Code::And) {
+                        for (size_t i = 0; i < n; ++i) dst[i] &= src[i];
+                    } else {
+                        for (size_t i = 0; i < n; ++i) dst[i] |= src[i];
+                    }
+                }
+                top -= ins.arity - 1;
+            }
+            mask.assignBytes(begin, &stack[0], n);
+        }
+        return mask;
+    }
+
+private:
+    enum class Code { Compare, And, Or };
+
+    struct Instruction {
+        Code code;
+        size_t column = 0;
+        Op op = Op::Equal;
+        T value = T();
+        size_t arity = 0;
+    };
+
+    void compile(const FilterExpr<T>& expr, const std::vector<std::string>& columns, size_t& depth) {
+        if (expr.kind() == FilterExpr<T>::Kind::Compare) {
+            auto it = std::find(columns.begin(), columns.end(), expr.column());
+            if (it == columns.end()) {
+                throw std::invalid_argument("Column does not exist: " + expr.column());
+            }
+            Instruction ins;
+            ins.code = Code::Compare;
+            ins.column = static_cast<size_t>(it - columns.begin());
+            ins.op = expr.op();
+            ins.value = expr.value();
+            program_.push_back(ins);
+            maxDepth_ = std::max(maxDepth_, ++depth);
+            return;
+        }
+
+        for (const auto& child : expr.children()) {
+            compile(child, columns, depth);
+        }
+        Instruction ins;
+        ins.code = expr.kind() == FilterExpr<T>::Kind::And ? Code::And : Code::Or;
+        ins.arity = expr.children().size();
+        program_.push_back(ins);
+        depth -= ins.arity - 1;
+    }
+
+    template <typename Cmp>
+    static void compareBlock(const T* values, size_t n, const T& ref, uint8_t* out, Cmp cmp) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<uint8_t>(cmp(values[i], ref));
+        }
+    }
+
+    static void compare(const Instruction& ins, const T* values, size_t n, uint8_t* out) {
+        switch (ins.op) {
+            case Op::Equal:        compareBlock(values, n, ins.value, out, [](const T& a, const T& b) { return a == b; }); break;
+            case Op::NotEqual:     compareBlock(values, n, ins.value, out, [](const T& a, const T& b) { return a != b; }); break;
+            case Op::Less:         compareBlock(values, n, ins.value, out, [](const T& a, const T& b) { return a < b; }); break;
+            case Op::LessEqual:    compareBlock(values, n, ins.value, out, [](const T& a, const T& b) { return a <= b; }); break;
+            case Op::Greater:      compareBlock(values, n, ins.value, out, [](const T& a, const T& b) { return a > b; }); break;
+            case Op::GreaterEqual: compareBlock(values, n, ins.value, out, [](const T& a, const T& b) { return a >= b; }); break;
+            case Op::NotEmpty:     compareBlock(values, n, T(), out, [](const T& a, const T& b) { return a != b; }); break;
+        }
+    }
+
+    std::vector<Instruction> program_;
+    size_t maxDepth_ = 0;
+};
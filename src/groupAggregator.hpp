@@ -0,0 +1,257 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include <memory_resource>
+#include "bitmap.hpp"
+#include "columnStats.hpp"
+#include "radix.hpp"
+#include "arena.hpp"
+
+// Como agregar, escolhido pelas estatísticas da coluna de agrupamento
+enum class AggregationStrategy {
+    DenseInteger,      // chaves inteiras em uma faixa pequena: vetor indexado por chave - min
+    SmallDictionary,   // poucos valores distintos (status, payment_method, seat_type): busca linear
+    HashTable,         // cardinalidade média (destino, voo): endereçamento aberto
+    RadixPartitioned   // cardinalidade alta (usuário): particiona por hash antes de agregar
+};
+
+constexpr uint64_t kDenseMaxRange = uint64_t(1) << 16;   // vetores de até ~1 MB
+constexpr size_t kSmallDictionaryMax = 16;
+constexpr size_t kHashTableMaxGroups = size_t(1) << 16;  // tabela cabe na L2
+
+template <typename T>
+AggregationStrategy chooseAggregation(const ColumnStats<T>& stats) {
+    if (stats.isInteger() && stats.integerRange() <= kDenseMaxRange &&
+        (stats.integerRange() <= 4096 || stats.integerDensity() >= 0.125)) {
+        return AggregationStrategy::DenseInteger;
+    }
+    if (stats.distinctEstimate() <= kSmallDictionaryMax) {
+        return AggregationStrategy::SmallDictionary;
+    }
+    if (stats.distinctEstimate() <= kHashTableMaxGroups) {
+        return AggregationStrategy::HashTable;
+    }
+    return AggregationStrategy::RadixPartitioned;
+}
+
+// Soma e contagem de values por chave de keys (só nas linhas de valid). Os grupos saem em
+// ordem crescente de chave, como no std::map usado antes. V é o tipo da soma: int64_t para
+// valores em ponto fixo (DecimalColumn, soma exata) ou double. As somas em int64_t não testam
+// overflow: DecimalColumn só é exata se a soma dos módulos de todas as linhas cabe em int64.
+template <typename V>
+class GroupAggregator {
+public:
+    struct Group {
+        std::string key;
+        V sum = V();
+        size_t count = 0;
+    };
+
+    // values já convertidos, um por linha de keys
+    template <typename T>
+    static std::vector<Group> aggregate(const std::vector<std::string>& keys, const std::vector<V>& values,
+                                        const Bitmap& valid, const ColumnStats<T>& stats) {
+        std::vector<Group> groups;
+        switch (chooseAggregation(stats)) {
+            case AggregationStrategy::DenseInteger:
+                groups = denseInteger(keys, values, valid, stats.min(), stats.integerRange());
+                break;
+            case AggregationStrategy::SmallDictionary:
+                groups = smallDictionary(keys, values, valid);
+                break;
+            case AggregationStrategy::HashTable:
+                groups = hashTable(keys, values, valid, stats.distinctEstimate());
+                break;
+            case AggregationStrategy::RadixPartitioned:
+                groups = stats.isInteger() ? radixInteger(keys, values, valid)
+                                           : radixPartitioned(keys, values, valid, stats.distinctEstimate());
+                break;
+        }
+        std::sort(groups.begin(), groups.end(), [](const Group& a, const Group& b) { return a.key < b.key; });
+        return groups;
+    }
+
+private:
+    struct Slot {
+        std::string_view key;
+        V sum = V();
+        size_t count = 0;
+        bool used = false;
+        size_t hash = 0;  // guardado para reposicionar a entrada quando a tabela cresce
+    };
+
+    static std::vector<Group> denseInteger(const std::vector<std::string>& keys, const std::vector<V>& values,
+                                           const Bitmap& valid, int64_t min, uint64_t range) {
+        std::pmr::vector<V> sums(range, V(), batchResource());
+        std::pmr::vector<size_t> counts(range, 0, batchResource());
+        valid.forEachSet([&](size_t i) {
+            int64_t key = 0;
+            parseCanonicalInt(keys[i], key);
+            sums[key - min] += values[i];
+            ++counts[key - min];
+        });
+
+        std::vector<Group> groups;
+        for (uint64_t k = 0; k < range; ++k) {
+            if (counts[k]) groups.push_back({std::to_string(min + static_cast<int64_t>(k)), sums[k], counts[k]});
+        }
+        return groups;
+    }
+
+    static std::vector<Group> smallDictionary(const std::vector<std::string>& keys, const std::vector<V>& values,
+                                              const Bitmap& valid) {
+        std::pmr::vector<Slot> slots(batchResource());
+        size_t last = 0;
+        bool overflow = false;
+        valid.forEachSet([&](size_t i) {
+            if (overflow) return;
+            std::string_view key = keys[i];
+            // linhas vizinhas costumam repetir a chave: testa a última antes de procurar
+            if (last >= slots.size() || slots[last].key != key) {
+                last = 0;
+                while (last < slots.size() && slots[last].key != key) ++last;
+                if (last == slots.size()) {
+                    // a estimativa errou por muito: a busca linear deixaria de compensar
+                    if (slots.size() == 4 * kSmallDictionaryMax) {
+                        overflow = true;
+                        return;
+                    }
+                    slots.push_back({key, V(), 0, true});
+                }
+            }
+            slots[last].sum += values[i];
+            ++slots[last].count;
+        });
+        if (overflow) {
+            return hashTable(keys, values, valid, 16 * kSmallDictionaryMax);
+        }
+        return toGroups(slots);
+    }
+
+    // tabela de endereçamento aberto (sondagem linear) sobre string_view das chaves
+    class FlatTable {
+    public:
+        explicit FlatTable(size_t expectedGroups) : slots_(batchResource()) {
+            size_t capacity = 16;
+            while (capacity < 2 * expectedGroups) capacity <<= 1;
+            slots_.resize(capacity);
+        }
+
+        Slot& find(std::string_view key, size_t hash) {
+            if (2 * (size_ + 1) > slots_.size()) grow();
+            size_t mask = slots_.size() - 1;
+            size_t slot = hash & mask;
+            while (slots_[slot].used && slots_[slot].key != key) {
+                slot = (slot + 1) & mask;
+            }
+            if (!slots_[slot].used) {
+                slots_[slot] = {key, V(), 0, true, hash};
+                ++size_;
+            }
+            return slots_[slot];
+        }
+
+        const std::pmr::vector<Slot>& slots() const { return slots_; }
+
+    private:
+        void grow() {
+            std::pmr::vector<Slot> old(std::move(slots_));
+            slots_ = std::pmr::vector<Slot>(old.size() * 2, batchResource());
+            size_t mask = slots_.size() - 1;
+            for (const Slot& entry : old) {
+                if (!entry.used) continue;
+                size_t slot = entry.hash & mask;
+                while (slots_[slot].used) slot = (slot + 1) & mask;
+                slots_[slot] = entry;
+            }
+        }
+
+        std::pmr::vector<Slot> slots_;
+        size_t size_ = 0;
+    };
+
+    static std::vector<Group> hashTable(const std::vector<std::string>& keys, const std::vector<V>& values,
+                                        const Bitmap& valid, size_t expectedGroups) {
+        FlatTable table(expectedGroups);
+        std::hash<std::string_view> hasher;
+        valid.forEachSet([&](size_t i) {
+            std::string_view key = keys[i];
+            Slot& slot = table.find(key, hasher(key));
+            slot.sum += values[i];
+            ++slot.count;
+        });
+        return toGroups(table.slots());
+    }
+
+    // chaves de texto com muitos grupos: as linhas são distribuídas por partição (bits altos do
+    // hash) e cada partição é agregada com uma tabela pequena, que fica na cache
+    static std::vector<Group> radixPartitioned(const std::vector<std::string>& keys, const std::vector<V>& values,
+                                               const Bitmap& valid, size_t expectedGroups) {
+        int bits = 1;
+        while (bits < 10 && (expectedGroups >> bits) > 4096) ++bits;
+        const size_t partitions = size_t(1) << bits;
+        const int shift = 64 - bits;
+
+        std::hash<std::string_view> hasher;
+        std::pmr::vector<uint64_t> hashes(keys.size(), 0, batchResource());
+        std::pmr::vector<size_t> start(partitions + 1, 0, batchResource());
+        valid.forEachSet([&](size_t i) {
+            hashes[i] = static_cast<uint64_t>(hasher(keys[i])) * 0x9E3779B97F4A7C15ull;
+            ++start[(hashes[i] >> shift) + 1];
+        });
+        for (size_t p = 0; p < partitions; ++p) start[p + 1] += start[p];
+
+        std::pmr::vector<size_t> next(start.begin(), start.end() - 1, batchResource());
+        std::pmr::vector<size_t> rows(start[partitions], batchResource());
+        valid.forEachSet([&](size_t i) { rows[next[hashes[i] >> shift]++] = i; });
+
+        std::vector<Group> groups;
+        for (size_t p = 0; p < partitions; ++p) {
+            FlatTable table((expectedGroups >> bits) + 1);
+            for (size_t r = start[p]; r < start[p + 1]; ++r) {
+                size_t i = rows[r];
+                Slot& slot = table.find(keys[i], static_cast<size_t>(hashes[i]));
+                slot.sum += values[i];
+                ++slot.count;
+            }
+            std::vector<Group> part = toGroups(table.slots());
+            groups.insert(groups.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+        }
+        return groups;
+    }
+
+    // chaves inteiras com muitos grupos: radixAggregate sobre os inteiros
+    static std::vector<Group> radixInteger(const std::vector<std::string>& keys, const std::vector<V>& values,
+                                           const Bitmap& valid) {
+        std::vector<int64_t> intKeys;
+        std::vector<V> selected;
+        intKeys.reserve(valid.count());
+        selected.reserve(valid.count());
+        valid.forEachSet([&](size_t i) {
+            int64_t key = 0;
+            parseCanonicalInt(keys[i], key);
+            intKeys.push_back(key);
+            selected.push_back(values[i]);
+        });
+
+        std::vector<Group> groups;
+        for (const auto& group : radixAggregate(intKeys, selected)) {
+            groups.push_back({std::to_string(group.key), group.sum, group.count});
+        }
+        return groups;
+    }
+
+    template <typename Slots>
+    static std::vector<Group> toGroups(const Slots& slots) {
+        std::vector<Group> groups;
+        for (const Slot& slot : slots) {
+            if (slot.used) groups.push_back({std::string(slot.key), slot.sum, slot.count});
+        }
+        return groups;
+    }
+};
@@ -14,6 +14,11 @@
 #include <unordered_map>
 #include <algorithm>
 #include "dataframe.hpp"
+#include "typedFrame.hpp"
+#include "lazyFrame.hpp"
+#include "dimensionLookup.hpp"
+#include "decimal.hpp"
+#include "rollupCube.hpp"
 
 class Trigger;
 
@@ -99,53 +104,95 @@ public:
 
 class ValidationHandler : public BaseHandler {
 public:
+    // mantém só as linhas com flight_id presente (não nulo e não vazio)
+    void addToPlan(LazyFrame<std::string>& plan) const {
+        plan.notNull("flight_id")
+            .filter(FilterExpr<std::string>::where("flight_id", ColumnPredicate::Op::NotEmpty));
+    }
+
     DataFrame<std::string> process(DataFrame<std::string>& df) override {
-        for (int i = 0; i < df.numRows(); ++i) {
-            if (df.getValue("flight_id", i).empty()) {
-                df.deleteLine(i);
-            }
-        }
+        LazyFrame<std::string> plan(std::move(df));
+        addToPlan(plan);
+        df = plan.collect();
         return df;
     }
 };
 
 class DateHandler : public BaseHandler {
+private:
+    TimeUnit unit;
+
 public:
+    explicit DateHandler(TimeUnit unit = TimeUnit::Day) : unit(unit) {}
+
+    // reservation_time passa a ter só o período (por padrão a data, yyyy-mm-dd), lido pelo
+    // parser ISO-8601 de dateTime.hpp; texto que não é data/hora fica como está
+    void addToPlan(LazyFrame<std::string>& plan) const {
+        plan.map("reservation_time", [unit = unit](const std::string& datetime) {
+            std::string period;
+            return truncateIsoDateTime(datetime, unit, period) ? period : datetime;
+        });
+    }
+
     DataFrame<std::string> process(DataFrame<std::string>& df) override {
-        for (int i = 0; i < df.numRows(); ++i) {
-            std::string datetime = df.getValue("reservation_time", i);
-            if (datetime.length() >= 10) {
-                df.updateValue("reservation_time", i, datetime.substr(0, 10));
-            }
-        }
+        LazyFrame<std::string> plan(std::move(df));
+        addToPlan(plan);
+        df = plan.collect();
         return df;
     }
 };
 
 class RevenueHandler : public BaseHandler {
 private:
-    double totalRevenue = 0.0;
+    int64_t totalRevenueCents = 0;  // em centavos: a soma é exata
     mutable std::mutex revenueMutex;
 
 public:
     DataFrame<std::string> process(DataFrame<std::string>& df) override {
-        DataFrame<std::string> groupedDf = df.groupby("reservation_time", "price");
+        // receita por dia com chaves inteiras (dias desde 1970), ver DataFrame::groupbyTime
+        DataFrame<std::string> groupedDf = df.groupbyTime("reservation_time", "price", TimeUnit::Day);
+        ColumnHandle status = df.column("status");
+        ColumnHandle price = df.column("price");
+        int64_t total = 0;
         for (int i = 0; i < df.numRows(); ++i) {
-            if (df.getValue("status", i) == "confirmed") {
-                totalRevenue += std::stod(df.getValue("price", i));
+            int64_t cents;
+            if (!df.isNull(price, i) && df.getValue(status, i) == "confirmed" && parseCents(df.getValue(price, i), cents)) {
+                total += cents;
             }
         }
+        std::lock_guard<std::mutex> lock(revenueMutex);
+        totalRevenueCents += total;
         return groupedDf;
     }
 
+    // versão tipada: status e price são lidos direto dos arrays do ReservationFrame
+    void process(const ReservationFrame& frame) {
+        const std::vector<std::string>& status = frame.col<reservation::status>();
+        const std::vector<double>& price = frame.col<reservation::price>();
+        int64_t total = 0;
+        for (size_t i = 0; i < frame.numRows(); ++i) {
+            if (status[i] == "confirmed") {
+                total += std::llround(price[i] * 100.0);
+            }
+        }
+        std::lock_guard<std::mutex> lock(revenueMutex);
+        totalRevenueCents += total;
+    }
+
     double getTotalRevenue() const {
         std::lock_guard<std::mutex> lock(revenueMutex);
-        return totalRevenue;
+        return static_cast<double>(totalRevenueCents) / 100.0;
+    }
+
+    // total exato em texto ("1234.50")
+    std::string getTotalRevenueText() const {
+        std::lock_guard<std::mutex> lock(revenueMutex);
+        return formatDecimal(totalRevenueCents, 2);
     }
 
     void resetRevenue() {
         std::lock_guard<std::mutex> lock(revenueMutex);
-        totalRevenue = 0.0;
+        totalRevenueCents = 0;
     }
 };
 
@@ -163,43 +210,28 @@ private:
 public:
     StatusFilterHandler(const std::string& status) : targetStatus(status) {}
 
+    void addToPlan(LazyFrame<std::string>& plan) const {
+        plan.filter("status", "==", targetStatus);
+    }
+
     DataFrame<std::string> process(DataFrame<std::string>& df) override {
-        for (int i = df.numRows() - 1; i >= 0; --i) {
-            if (df.getValue("status", i) != targetStatus) {
-                df.deleteLine(i);
-            }
-        }
+        LazyFrame<std::string> plan(std::move(df));
+        addToPlan(plan);
+        df = plan.collect();
         return df;
     }
 };
 
-int extractFlightNumber(const std::string& flightId) {
-    size_t dashPos = flightId.find('-');
-    if (dashPos != std::string::npos && dashPos + 1 < flightId.size()) {
-        try {
-            return std::stoi(flightId.substr(dashPos + 1));
-        } catch (...) {
-            try {
-                return std::stoi(flightId);
-            } catch (...) {
-                return -1;
-            }
-        }
-    }
-    
-    try {
-        return std::stoi(flightId);
-    } catch (...) {
-        return -1;
-    }
-}
-
 class FlightInfoEnricherHandler : public BaseHandler {
 private:
     DataFrame<std::string> flightsDf;
+    DimensionLookup<int> flightNumberToIndex;  // número do voo -> linha de flightsDf
 
 public:
-    FlightInfoEnricherHandler(const DataFrame<std::string>& flightsDf) : flightsDf(flightsDf) {}
+    FlightInfoEnricherHandler(const DataFrame<std::string>& flightsDf) : flightsDf(flightsDf) {
+        // montado uma vez: com ids 1..n a busca é um acesso direto a um vetor
+        flightNumberToIndex = this->flightsDf.surrogateKeys("flight_id").rowLookup();
+    }
 
     std::vector<DataFrame<std::string>> processMulti(const std::vector<DataFrame<std::string>>& inputDfs) override {
         if (inputDfs.empty()) {
@@ -207,7 +239,16 @@ public:
         }
 
         DataFrame<std::string> reservationsDf = inputDfs[0];
+        // números de voo já calculados na extração (a cópia não leva o cache)
+        if (const SurrogateKeyColumn* cached = inputDfs[0].cachedSurrogateKeys("flight_id")) {
+            reservationsDf.setSurrogateKeys("flight_id", cached->keys());
+        }
+        return enrich(std::move(reservationsDf));
+    }
 
+    // Enriquecimento sobre o próprio DataFrame: quem passa a partição com std::move evita a cópia
+    // e mantém as chaves de flight_id já calculadas
+    std::vector<DataFrame<std::string>> enrich(DataFrame<std::string> reservationsDf) {
         if (!reservationsDf.columnExists("origin")) {
             reservationsDf.addColumn("origin", Series<std::string>::createEmpty(reservationsDf.numRows(), ""));
         }
@@ -219,34 +260,38 @@ public:
         flightStatsDf.addColumn("flight_number", Series<std::string>::createEmpty(0, ""));
         flightStatsDf.addColumn("reservation_count", Series<std::string>::createEmpty(0, ""));
 
-        std::unordered_map<int, int> flightCounts;
+        // números de voo das reservas, contados no fim com agregação particionada por radix
+        std::vector<int64_t> flightNumbers;
+        flightNumbers.reserve(reservationsDf.numRows());
 
-        std::unordered_map<int, int> flightNumberToIndex;
-        for (int j = 0; j < flightsDf.numRows(); ++j) {
-            int flightNum = extractFlightNumber(flightsDf.getValue("flight_id", j));
-            if (flightNum != -1) {
-                flightNumberToIndex[flightNum] = j;
-            }
-        }
+        ColumnHandle flightsFrom = flightsDf.column("from");
+        ColumnHandle flightsTo = flightsDf.column("to");
+        ColumnHandle origin = reservationsDf.column("origin");
+        ColumnHandle destination = reservationsDf.column("destination");
+
+        const SurrogateKeyColumn& flightKeys = reservationsDf.surrogateKeys("flight_id");
 
         for (int i = 0; i < reservationsDf.numRows(); ++i) {
-            int flightNum = extractFlightNumber(reservationsDf.getValue("flight_id", i));
-            if (flightNum == -1) continue;
+            int64_t flightNum = flightKeys[i];
+            if (flightNum == SurrogateKeyColumn::kNoKey) continue;
 
-            flightCounts[flightNum]++;
+            flightNumbers.push_back(flightNum);
 
-            if (flightNumberToIndex.count(flightNum)) {
-                int flightIdx = flightNumberToIndex[flightNum];
-                reservationsDf.updateValue("origin", i, flightsDf.getValue("from", flightIdx));
-                reservationsDf.updateValue("destination", i, flightsDf.getValue("to", flightIdx));
+            if (const int* flightIdx = flightNumberToIndex.find(flightNum)) {
+                reservationsDf.updateValue(origin, i, flightsDf.getValue(flightsFrom, *flightIdx));
+                reservationsDf.updateValue(destination, i, flightsDf.getValue(flightsTo, *flightIdx));
             }
         }
 
-        for (const auto& [flightNum, count] : flightCounts) {
-            flightStatsDf.addLine({std::to_string(flightNum), std::to_string(count)});
+        for (const auto& group : radixCount(flightNumbers)) {
+            flightStatsDf.addLine({std::to_string(group.key), std::to_string(group.count)});
         }
 
-        return {reservationsDf, flightStatsDf};
+        // push_back com move: uma lista {...} copiaria o DataFrame (e perderia as chaves em cache)
+        std::vector<DataFrame<std::string>> results;
+        results.push_back(std::move(reservationsDf));
+        results.push_back(std::move(flightStatsDf));
+        return results;
     }
 
     DataFrame<std::string> process(DataFrame<std::string>& df) override {
@@ -264,59 +309,48 @@ class DestinationCounterHandler : public BaseHandler {
                 return resultDf;
             }
 
-            std::map<std::string, int> destinationCount;
-            for (int i = 0; i < enrichedDf.numRows(); ++i) {
-                destinationCount[enrichedDf.getValue("destination", i)]++;
+            std::pmr::map<std::string_view, int> destinationCount(batchResource());
+            for (const auto& destination : enrichedDf.values(enrichedDf.column("destination"))) {
+                destinationCount[destination]++;
             }
     
-            std::vector<std::pair<std::string, int>> sortedDestinations(
-                destinationCount.begin(), destinationCount.end());
-            
-            std::sort(sortedDestinations.begin(), sortedDestinations.end(),
-                [](const auto& a, const auto& b) {
-                    return a.second > b.second; 
-                });
-
             Series<std::string> countries;
             Series<std::string> counts;
     
-            for (const auto& [country, count] : sortedDestinations) {
-                countries.addElement(country);
+            for (const auto& [country, count] : destinationCount) {
+                countries.addElement(std::string(country));
                 counts.addElement(std::to_string(count));
             }
     
-            resultDf.addColumn("destination", countries);
-            resultDf.addColumn("reservation_count", counts);
+            resultDf.addColumn("destination", std::move(countries));
+            resultDf.addColumn("reservation_count", std::move(counts));
     
-            return resultDf;
+            // mais reservas primeiro; empates continuam em ordem alfabética (sort estável)
+            return resultDf.sortBy({"reservation_count"}, {false});
         }
     };
     
 class UsersCountryRevenue : public BaseHandler {
     private:
-        const std::unordered_map<std::string, std::string>& userIdToCountry;
+        const DimensionLookup<std::string>& userIdToCountry;
     
     public:
-        UsersCountryRevenue(const std::unordered_map<std::string, std::string>& map)
-            : userIdToCountry(map) {}
+        UsersCountryRevenue(const DimensionLookup<std::string>& lookup)
+            : userIdToCountry(lookup) {}
     
         DataFrame<std::string> process(DataFrame<std::string>& df) override {
-            Series<std::string> flight_ids, seats, countries, prices;
+            // só as colunas usadas no groupby
+            DataFrameBuilder<std::string> builder({"user_country", "price"}, df.numRows());
+            const std::string unknown = "Unknown";
+            ColumnHandle userIdColumn = df.column("user_id");
+            ColumnHandle priceColumn = df.column("price");
     
             for (int i = 0; i < df.numRows(); ++i) {
-                std::string userId = df.getValue("user_id", i);
-                std::string country = userIdToCountry.count(userId) ? userIdToCountry.at(userId) : "Unknown";
-    
-                flight_ids.addElement(df.getValue("flight_id", i));
-                seats.addElement(df.getValue("seat", i));
-                countries.addElement(country);
-                prices.addElement(df.getValue("price", i));
+                const std::string* country = userIdToCountry.find(std::string_view(df.getValue(userIdColumn, i)));
+                builder.addRow({country ? *country : unknown, df.getValue(priceColumn, i)});
             }
     
-            DataFrame<std::string> enrichedDf(
-                {"flight_id", "seat", "user_country", "price"},
-                {flight_ids, seats, countries, prices}
-            );
+            DataFrame<std::string> enrichedDf = builder.build();
     
             return enrichedDf.groupby("user_country", "price");
         }
@@ -325,48 +359,96 @@ class UsersCountryRevenue : public BaseHandler {
 
 class SeatTypeRevenue : public BaseHandler {
 private:
-    const std::unordered_map<std::string, std::string>& seatKeyToClass;
+    const CompositeLookup<std::string>& seatKeyToClass;
 
 public:
-    SeatTypeRevenue(const std::unordered_map<std::string, std::string>& map)
-        : seatKeyToClass(map) {}
+    SeatTypeRevenue(const CompositeLookup<std::string>& lookup)
+        : seatKeyToClass(lookup) {}
 
     DataFrame<std::string> process(DataFrame<std::string>& df) override {
-        Series<std::string> flight_ids, seats, seat_types, prices;
+        DataFrameBuilder<std::string> builder({"seat_type", "price"}, df.numRows());
 
-        // Prefixo a ser removido
-        const std::string flightPrefix = "AAA-"; 
+        const std::string economy = "Econômica";
 
-        for (int i = 0; i < df.numRows(); ++i) {
-            std::string flightId = df.getValue("flight_id", i);
-            std::string seat = df.getValue("seat", i);
+        // número do voo ("AAA-12" -> 12) da coluna de chaves substitutas: sem substr por linha
+        const SurrogateKeyColumn& flightKeys = df.surrogateKeys("flight_id");
+        ColumnHandle seatColumn = df.column("seat");
+        ColumnHandle priceColumn = df.column("price");
 
-            // Remove o prefixo "AAA-" do flight_id
-            if (flightId.find(flightPrefix) == 0) {
-                flightId = flightId.substr(flightPrefix.length()); 
+        for (int i = 0; i < df.numRows(); ++i) {
+            const std::string* seatType = nullptr;
+            if (flightKeys[i] != SurrogateKeyColumn::kNoKey) {
+                seatType = seatKeyToClass.find(flightKeys[i], df.getValue(seatColumn, i));
             }
 
-            // Formar a chave completa
-            std::string key = flightId + "_" + seat;
-
-            // Verificar se a chave está no mapa
-            std::string seatType = seatKeyToClass.count(key) ? seatKeyToClass.at(key) : "Econômica";
-
-            flight_ids.addElement(flightId);
-            seats.addElement(seat);
-            seat_types.addElement(seatType);
-            prices.addElement(df.getValue("price", i));
+            builder.addRow({seatType ? *seatType : economy, df.getValue(priceColumn, i)});
         }
 
-        DataFrame<std::string> enrichedDf(
-            {"flight_id", "seat", "seat_type", "price"},
-            {flight_ids, seats, seat_types, prices}
-        );
+        DataFrame<std::string> enrichedDf = builder.build();
 
         return enrichedDf.groupby("seat_type", "price");
     }
 };
 
+// Soma as reservas (já validadas e enriquecidas com destination) em um RollupCube: cada linha
+// vai para a célula dia × payment_method × user_country × seat_type × destination, com os
+// mesmos joins e padrões de UsersCountryRevenue e SeatTypeRevenue. As tabelas de faturamento
+// e de destinos saem depois de rollups do cubo, sem um groupby por tabela.
+class RollupCubeHandler : public BaseHandler {
+private:
+    const DimensionLookup<std::string>& userIdToCountry;
+    const CompositeLookup<std::string>& seatKeyToClass;
+
+public:
+    RollupCubeHandler(const DimensionLookup<std::string>& userLookup, const CompositeLookup<std::string>& seatLookup)
+        : userIdToCountry(userLookup), seatKeyToClass(seatLookup) {}
+
+    // preço inválido ou nulo conta como reserva sem receita; horário que não é ISO-8601 fica
+    // com o texto original como dia (como no DateHandler)
+    void addTo(RollupCube& cube, DataFrame<std::string>& df) const {
+        const std::string unknown = "Unknown";
+        const std::string economy = "Econômica";
+        const SurrogateKeyColumn& flightKeys = df.surrogateKeys("flight_id");
+        ColumnHandle timeColumn = df.column("reservation_time");
+        ColumnHandle paymentColumn = df.column("payment_method");
+        ColumnHandle userIdColumn = df.column("user_id");
+        ColumnHandle seatColumn = df.column("seat");
+        ColumnHandle destinationColumn = df.column("destination");
+        ColumnHandle priceColumn = df.column("price");
+
+        // o lote inteiro entra sob um só lock do cubo
+        std::string day;
+        cube.addRows(df.numRows(), [&](size_t row, RollupCube::Coordinates& coordinates, int64_t& cents) {
+            int i = static_cast<int>(row);
+            const std::string& time = df.getValue(timeColumn, i);
+            if (!truncateIsoDateTime(time, TimeUnit::Day, day)) {
+                day = time;
+            }
+
+            const std::string* country = userIdToCountry.find(std::string_view(df.getValue(userIdColumn, i)));
+            const std::string* seatType = nullptr;
+            if (flightKeys[i] != SurrogateKeyColumn::kNoKey) {
+                seatType = seatKeyToClass.find(flightKeys[i], df.getValue(seatColumn, i));
+            }
+
+            if (df.isNull(priceColumn, i) || !parseCents(df.getValue(priceColumn, i), cents)) {
+                cents = 0;
+            }
+
+            coordinates = {day, df.getValue(paymentColumn, i), country ? *country : unknown,
+                           seatType ? *seatType : economy, df.getValue(destinationColumn, i)};
+        });
+    }
+
+    // cubo só desta partição, no grão completo (todas as dimensões)
+    DataFrame<std::string> process(DataFrame<std::string>& df) override {
+        RollupCube cube;
+        addTo(cube, df);
+        return cube.rollup({CubeDimension::Day, CubeDimension::PaymentMethod, CubeDimension::UserCountry,
+                            CubeDimension::SeatType, CubeDimension::Destination});
+    }
+};
+
 class MeanPricePerDestination_AirlineHandler : public BaseHandler {
 public:
     // Método adicional para shared_ptr
@@ -406,20 +488,18 @@ public:
         DataFrame<std::string> resultDf = df2;
         resultDf.addColumn("avg_price", Series<std::string>::createEmpty(resultDf.numRows(), "0.0"));
 
-        // Mapear flight_id para índices
-        std::unordered_map<std::string, int> flightIdToIndex;
-        for (int i = 0; i < resultDf.numRows(); ++i) {
-            flightIdToIndex[resultDf.getValue("flight_id", i)] = i;
-        }
+        // Mapear número do voo para índices (join pela chave substituta inteira)
+        DimensionLookup<int> flightNumberToIndex = resultDf.surrogateKeys("flight_id").rowLookup();
 
         // Preencher preços médios
+        const SurrogateKeyColumn& avgFlightKeys = avgPriceDf.surrogateKeys("flight_id");
+        ColumnHandle meanPrice = avgPriceDf.column("mean_price");
+        ColumnHandle resultAvgPrice = resultDf.column("avg_price");
         for (int i = 0; i < avgPriceDf.numRows(); ++i) {
-            std::string flightId = avgPriceDf.getValue("flight_id", i);
-            std::string avgPrice = avgPriceDf.getValue("mean_price", i);
-            
-            if (flightIdToIndex.count(flightId)) {
-                int flightIdx = flightIdToIndex[flightId];
-                resultDf.updateValue("avg_price", flightIdx, avgPrice);
+            if (avgFlightKeys[i] == SurrogateKeyColumn::kNoKey) continue;
+
+            if (const int* flightIdx = flightNumberToIndex.find(avgFlightKeys[i])) {
+                resultDf.updateValue(resultAvgPrice, *flightIdx, avgPriceDf.getValue(meanPrice, i));
             }
         }
         
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+#include "dataframe.hpp"
+#include "filterExpr.hpp"
+#include "bitmap.hpp"
+
+// Plano de consulta preguiçoso sobre um DataFrame. filter/notNull/map/select só registram
+// passos; nada é materializado até collect(). Os passos linha a linha são fundidos em um
+// único laço: as linhas são percorridas em blocos de kBlockRows, cada passo atua sobre a
+// seleção do bloco (Bitmap) e, no fim do bloco, só as linhas que sobraram são copiadas para
+// as colunas de saída. Um map não gera uma coluna inteira nova: o valor transformado fica em
+// um buffer do tamanho do bloco, visto pelos passos seguintes no lugar do valor original.
+// groupby/groupbyMean executam o plano como collect(), mas materializam só as duas colunas
+// usadas na agregação.
+// Chaves substitutas já calculadas na origem (DataFrame::surrogateKeys) seguem as linhas
+// selecionadas para o resultado, desde que a coluna não passe por um map.
+template <typename T>
+class LazyFrame {
+public:
+    static constexpr size_t kBlockRows = 1024;
+
+    explicit LazyFrame(DataFrame<T> source) : source_(std::move(source)) {}
+
+    // mantém as linhas que satisfazem a expressão (avaliada com CompiledFilter por bloco)
+    LazyFrame& filter(const FilterExpr<T>& expr) {
+        Step step(Step::Kind::Filter);
+        step.expr.push_back(expr);
+        steps_.push_back(std::move(step));
+        return *this;
+    }
+
+    LazyFrame& filter(const std::string& columnName, const std::string& condition, const T& value) {
+        return filter(FilterExpr<T>::where(columnName, condition, value));
+    }
+
+    // descarta as linhas em que a coluna é nula
+    LazyFrame& notNull(const std::string& columnName) {
+        Step step(Step::Kind::NotNull);
+        step.column = columnName;
+        steps_.push_back(std::move(step));
+        return *this;
+    }
+
+    // substitui os valores da coluna por f(valor)
+    LazyFrame& map(const std::string& columnName, std::function<T(const T&)> f) {
+        Step step(Step::Kind::Map);
+        step.column = columnName;
+        step.f = std::move(f);
+        steps_.push_back(std::move(step));
+        return *this;
+    }
+
+    // colunas (e ordem) do resultado; por padrão, todas as do DataFrame de origem
+    LazyFrame& select(std::vector<std::string> columns) {
+        select_ = std::move(columns);
+        return *this;
+    }
+
+    // executa o plano
+    DataFrame<T> collect() {
+        if (steps_.empty() && select_.empty()) {
+            return std::move(source_);
+        }
+        return run();
+    }
+
+    DataFrame<std::string> groupby(const std::string& groupByColumn, const std::string& valueColumn) {
+        select_ = {groupByColumn, valueColumn};
+        return run().groupby(groupByColumn, valueColumn);
+    }
+
+    DataFrame<std::string> groupbyMean(const std::string& groupByColumn, const std::string& valueColumn) {
+        select_ = {groupByColumn, valueColumn};
+        return run().groupbyMean(groupByColumn, valueColumn);
+    }
+
+private:
+    struct Step {
+        enum class Kind { Filter, NotNull, Map };
+
+        explicit Step(Kind kind) : kind(kind) {}
+
+        Kind kind;
+        std::string column;
+        std::vector<FilterExpr<T>> expr;  // Filter (vazio nos demais)
+        std::function<T(const T&)> f;     // Map
+    };
+
+    DataFrame<T> run() const {
+        const std::vector<std::string>& columns = source_.getColumns();
+        const size_t numColumns = columns.size();
+        const size_t rows = static_cast<size_t>(source_.numRows());
+
+        std::vector<std::string> outputColumns = select_.empty() ? columns : select_;
+        std::vector<size_t> outputIndex;
+        for (const auto& name : outputColumns) {
+            outputIndex.push_back(indexOf(name));
+        }
+
+        // passos já resolvidos: índices de coluna e filtros compilados
+        std::vector<size_t> stepColumn(steps_.size(), 0);
+        std::vector<CompiledFilter<T>> compiled;
+        for (size_t s = 0; s < steps_.size(); ++s) {
+            if (steps_[s].kind == Step::Kind::Filter) {
+                compiled.emplace_back(steps_[s].expr.front(), columns);
+            } else {
+                stepColumn[s] = indexOf(steps_[s].column);
+            }
+        }
+
+        std::vector<const std::vector<T>*> sourceValues(numColumns);
+        std::vector<const Series<T>*> sourceSeries(numColumns);
+        for (size_t c = 0; c < numColumns; ++c) {
+            ColumnHandle handle(static_cast<int>(c));
+            sourceValues[c] = &source_.values(handle);
+            sourceSeries[c] = &source_[handle];
+        }
+
+        // chaves substitutas da origem que seguem para o resultado (colunas sem map)
+        std::vector<const SurrogateKeyColumn*> sourceKeys(outputColumns.size(), nullptr);
+        for (size_t o = 0; o < outputColumns.size(); ++o) {
+            bool mappedColumn = std::any_of(steps_.begin(), steps_.end(), [&](const Step& step) {
+                return step.kind == Step::Kind::Map && step.column == outputColumns[o];
+            });
+            if (!mappedColumn) sourceKeys[o] = source_.cachedSurrogateKeys(outputColumns[o]);
+        }
+        std::vector<std::vector<int64_t>> outputKeys(outputColumns.size());
+
+        std::vector<Series<T>> output(outputColumns.size());
+        std::vector<std::vector<T>> mapped(numColumns);
+        std::vector<const T*> current(numColumns);
+        std::vector<bool> isMapped(numColumns);
+
+        for (size_t begin = 0; begin < rows; begin += kBlockRows) {
+            size_t n = std::min(kBlockRows, rows - begin);
+            Bitmap selection(n, true);
+            for (size_t c = 0; c < numColumns; ++c) {
+                current[c] = sourceValues[c]->data() + begin;
+                isMapped[c] = false;
+            }
+
+            size_t nextFilter = 0;
+            for (size_t s = 0; s < steps_.size() && selection.count() != 0; ++s) {
+                const Step& step = steps_[s];
+                size_t c = stepColumn[s];
+                switch (step.kind) {
+                    case Step::Kind::Filter:
+                        selection &= compiled[nextFilter++].evaluate(current, n);
+                        break;
+                    case Step::Kind::NotNull:
+                        if (sourceSeries[c]->hasNulls()) {
+                            selection.forEachSet([&](size_t i) {
+                                if (sourceSeries[c]->isNull(begin + i)) selection.reset(i);
+                            });
+                        }
+                        break;
+                    case Step::Kind::Map:
+                        if (!isMapped[c]) {
+                            mapped[c].assign(n, T());
+                        }
+                        selection.forEachSet([&](size_t i) { mapped[c][i] = step.f(current[c][i]); });
+                        current[c] = mapped[c].data();
+                        isMapped[c] = true;
+                        break;
+                }
+            }
+
+            // só as linhas que passaram por todos os passos chegam às colunas de saída
+            for (size_t o = 0; o < outputIndex.size(); ++o) {
+                size_t c = outputIndex[o];
+                const bool checkNulls = sourceSeries[c]->hasNulls();  // nulo continua nulo após um map
+                selection.forEachSet([&](size_t i) {
+                    if (checkNulls && sourceSeries[c]->isNull(begin + i)) {
+                        output[o].addNull();
+                    } else {
+                        output[o].addElement(current[c][i]);
+                    }
+                });
+                if (sourceKeys[o]) {
+                    selection.forEachSet([&](size_t i) { outputKeys[o].push_back((*sourceKeys[o])[begin + i]); });
+                }
+            }
+        }
+
+        DataFrame<T> result(outputColumns, std::move(output));
+        if constexpr (std::is_same<T, std::string>::value) {
+            for (size_t o = 0; o < outputColumns.size(); ++o) {
+                if (sourceKeys[o]) result.setSurrogateKeys(outputColumns[o], std::move(outputKeys[o]));
+            }
+        }
+        return result;
+    }
+
+    size_t indexOf(const std::string& name) const {
+        const std::vector<std::string>& columns = source_.getColumns();
+        auto it = std::find(columns.begin(), columns.end(), name);
+        if (it == columns.end()) {
+            throw std::invalid_argument("Column does not exist: " + name);
+        }
+        return static_cast<size_t>(it - columns.begin());
+    }
+
+    DataFrame<T> source_;
+    std::vector<Step> steps_;
+    std::vector<std::string> select_;
+};
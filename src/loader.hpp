@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include "dataframe.hpp"
 #include "database.h"
+#include "decimal.hpp"
 
 class Loader {
 private:
@@ -55,12 +56,24 @@ public:
             // For revenue tables, we need to accumulate values
             std::string key_column = columns[0];
             std::string value_column = columns[1];
+            ColumnHandle keyHandle = df.column(key_column);
+            ColumnHandle valueHandle = df.column(value_column);
 
             for (int i = 0; i < df.numRows(); ++i) {
                 try {
-                    std::string key_value = df.getValue(key_column, i);
-                    std::string str_value = df.getValue(value_column, i);
-                    double new_value = std::stod(str_value);
+                    if (df.isNull(keyHandle, i) || df.isNull(valueHandle, i)) {
+                        continue;  // nothing to accumulate for null keys/values
+                    }
+                    const std::string& key_value = df.getValue(keyHandle, i);
+                    const std::string& str_value = df.getValue(valueHandle, i);
+
+                    // Same check for inserts and updates: only numbers are accumulated
+                    int64_t mantissa;
+                    int scale;
+                    double number;
+                    if (!parseDecimal(str_value, mantissa, scale) && !ColumnPredicate::parseNumber(str_value, number)) {
+                        throw std::invalid_argument("Invalid value for " + value_column + ": " + str_value);
+                    }
 
                     // Check if record exists using prepared statement
                     std::string select_sql = "SELECT " + value_column + " FROM " + table_name + 
@@ -68,12 +81,16 @@ public:
                     auto result = query(select_sql, {key_value});
 
                     if (!result.empty()) {
-                        // Record exists - update it by adding the new value
-                        double current_value = std::stod(result[0][0]);
+                        // Record exists - update it by adding the new value (exact decimal
+                        // addition when both are plain decimals, double otherwise)
+                        std::string total;
+                        if (!addDecimalText(result[0][0], str_value, total)) {
+                            total = std::to_string(std::stod(result[0][0]) + std::stod(str_value));
+                        }
                         std::string update_sql = "UPDATE " + table_name + 
                                                " SET " + value_column + " = ?" +
                                                " WHERE " + key_column + " = ?";
-                        database.execute(update_sql, {std::to_string(current_value + new_value), key_value});
+                        database.execute(update_sql, {total, key_value});
                     } else {
                         // Record doesn't exist - insert new
                         std::vector<std::string> values = {key_value, str_value};
@@ -99,11 +116,20 @@ public:
             }
             insertQuery += ") VALUES ";
 
+            std::vector<ColumnHandle> handles;
+            for (const auto& column : columns) {
+                handles.push_back(df.column(column));
+            }
+
             // Prepara a query para inserção em massa
             for (int i = 0; i < df.numRows(); ++i) {
                 insertQuery += "(";
                 for (size_t j = 0; j < columns.size(); ++j) {
-                    insertQuery += "'" + df.getValue(columns[j], i) + "'";
+                    if (df.isNull(handles[j], i)) {
+                        insertQuery += "NULL";
+                    } else {
+                        insertQuery += "'" + df.getValue(handles[j], i) + "'";
+                    }
                     if (j < columns.size() - 1) {
                         insertQuery += ", ";
                     }
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fstream>
+#include <sstream>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Arquivo mapeado em memória (somente leitura).
+// Em sistemas POSIX usa mmap; no Windows cai para uma leitura completa em buffer.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filePath) {
+#ifdef _WIN32
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open the file: " + filePath);
+        }
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        buffer_ = ss.str();
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#else
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Could not open the file: " + filePath);
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1) {
+            ::close(fd);
+            throw std::runtime_error("Could not stat the file: " + filePath);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+
+        // mmap não aceita tamanho zero; arquivo vazio fica com data_ nulo
+        if (size_ > 0) {
+            void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Could not map the file: " + filePath);
+            }
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(addr);
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    std::string buffer_;
+#endif
+};
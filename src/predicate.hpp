@@ -0,0 +1,162 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <stdexcept>
+#include <system_error>
+
+// Predicado simples sobre uma coluna (igualdade, faixa ou não-vazio).
+// Quando o valor de referência e o campo são numéricos a comparação é numérica;
+// caso contrário é lexicográfica (o que funciona para datas ISO-8601).
+class ColumnPredicate {
+public:
+    enum class Op { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, NotEmpty };
+
+    ColumnPredicate(const std::string& column, Op op, const std::string& value = "")
+        : column_(column), op_(op), value_(value) {
+        valueIsNumeric_ = parseNumber(value_, numericValue_);
+    }
+
+    ColumnPredicate(const std::string& column, const std::string& condition, const std::string& value)
+        : ColumnPredicate(column, parseOp(condition), value) {}
+
+    static ColumnPredicate equals(const std::string& column, const std::string& value) {
+        return ColumnPredicate(column, Op::Equal, value);
+    }
+
+    static ColumnPredicate notEmpty(const std::string& column) {
+        return ColumnPredicate(column, Op::NotEmpty);
+    }
+
+    // converte "==", "!=", "<", "<=", ">", ">=" no operador correspondente
+    static Op parseOp(const std::string& condition) {
+        if (condition == "==") return Op::Equal;
+        if (condition == "!=") return Op::NotEqual;
+        if (condition == "<") return Op::Less;
+        if (condition == "<=") return Op::LessEqual;
+        if (condition == ">") return Op::Greater;
+        if (condition == ">=") return Op::GreaterEqual;
+        throw std::invalid_argument("Invalid condition: " + condition);
+    }
+
+    const std::string& column() const { return column_; }
+    Op op() const { return op_; }
+    const std::string& value() const { return value_; }
+
+    bool matches(std::string_view field) const {
+        if (op_ == Op::NotEmpty) {
+            return !field.empty();
+        }
+
+        double number;
+        if (valueIsNumeric_ && parseNumber(field, number)) {
+            return matchesNumber(number);
+        }
+        return accepts(field.compare(value_));
+    }
+
+    // comparação direta com um valor já numérico (colunas tipadas)
+    bool matchesNumber(double number) const {
+        if (op_ == Op::NotEmpty) {
+            return true;
+        }
+        return accepts((number < numericValue_) ? -1 : (number > numericValue_ ? 1 : 0));
+    }
+
+    // true se algum valor em [min, max] pode satisfazer o predicado
+    bool mayMatchRange(double min, double max) const {
+        switch (op_) {
+            case Op::Equal:        return min <= numericValue_ && numericValue_ <= max;
+            case Op::Less:         return min < numericValue_;
+            case Op::LessEqual:    return min <= numericValue_;
+            case Op::Greater:      return max > numericValue_;
+            case Op::GreaterEqual: return max >= numericValue_;
+            default:               return true;
+        }
+    }
+
+    bool mayMatchRange(const std::string& min, const std::string& max) const {
+        switch (op_) {
+            case Op::Equal:        return min <= value_ && value_ <= max;
+            case Op::Less:         return min < value_;
+            case Op::LessEqual:    return min <= value_;
+            case Op::Greater:      return max > value_;
+            case Op::GreaterEqual: return max >= value_;
+            default:               return true;
+        }
+    }
+
+    // trecho de WHERE com um placeholder '?' (ou nenhum, para NotEmpty), com o valor ligado
+    // como texto. Só equivale a matches() para valores não numéricos: numa coluna TEXT o SQLite
+    // compara "99.5" > "100" como texto, e matches() compara como número
+    std::string toSql() const {
+        const std::string column = quoteIdentifier(column_);
+        switch (op_) {
+            case Op::Equal:        return column + " = ?";
+            case Op::NotEqual:     return column + " <> ?";
+            case Op::Less:         return column + " < ?";
+            case Op::LessEqual:    return column + " <= ?";
+            case Op::Greater:      return column + " > ?";
+            case Op::GreaterEqual: return column + " >= ?";
+            default:               return "(" + column + " IS NOT NULL AND " + column + " <> '')";
+        }
+    }
+
+    // identificador SQL entre aspas duplas ("col" -> "\"col\"", aspas internas dobradas)
+    static std::string quoteIdentifier(const std::string& name) {
+        std::string quoted = "\"";
+        for (char c : name) {
+            if (c == '"') quoted += '"';
+            quoted += c;
+        }
+        quoted += '"';
+        return quoted;
+    }
+
+    bool hasSqlParameter() const { return op_ != Op::NotEmpty; }
+    bool valueIsNumeric() const { return valueIsNumeric_; }
+    double numericValue() const { return numericValue_; }
+
+    // true se o texto inteiro é um número
+    static bool parseNumber(std::string_view text, double& out) {
+        if (text.empty()) {
+            return false;
+        }
+        const char* begin = text.data();
+        const char* end = text.data() + text.size();
+        if (*begin == '+') ++begin;
+        auto result = std::from_chars(begin, end, out);
+        return result.ec == std::errc() && result.ptr == end;
+    }
+
+    static bool isInteger(std::string_view text) {
+        if (!text.empty() && (text[0] == '-' || text[0] == '+')) text.remove_prefix(1);
+        if (text.empty()) return false;
+        for (char c : text) {
+            if (c < '0' || c > '9') return false;
+        }
+        return true;
+    }
+
+private:
+    // traduz o resultado de uma comparação (-1, 0, 1) conforme o operador
+    bool accepts(int cmp) const {
+        switch (op_) {
+            case Op::Equal:        return cmp == 0;
+            case Op::NotEqual:     return cmp != 0;
+            case Op::Less:         return cmp < 0;
+            case Op::LessEqual:    return cmp <= 0;
+            case Op::Greater:      return cmp > 0;
+            case Op::GreaterEqual: return cmp >= 0;
+            default:               return true;
+        }
+    }
+
+    std::string column_;
+    Op op_;
+    std::string value_;
+    bool valueIsNumeric_ = false;
+    double numericValue_ = 0.0;
+};
@@ -25,7 +25,7 @@ public:
         std::unique_lock<std::mutex> lock(mutex_);
         cv_.wait(lock, [this] { return queue_.size() < capacity_; });  // espera até ter espaço na fila
 
-        queue_.push(item);
+        queue_.push(std::move(item));
         cv_.notify_one();  // notifica uma thread que pode consumir
     }
 
@@ -34,7 +34,7 @@ public:
         std::unique_lock<std::mutex> lock(mutex_);
         cv_.wait(lock, [this] { return !queue_.empty(); });  // espera até ter item para remover
 
-        std::pair<U, V> item = queue_.front();
+        std::pair<U, V> item = std::move(queue_.front());
         queue_.pop();
 
         cv_.notify_one();  // notifica uma thread que pode adicionar
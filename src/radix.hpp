@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+// Ordenação radix (LSD) e agregação particionada por radix para chaves inteiras.
+// As chaves são levadas para uint64_t preservando a ordem; cada passada estável distribui
+// por um dígito de 8 bits e passadas em que todas as chaves têm o mesmo dígito são puladas
+// (chaves pequenas, como números de voo ou dias, custam só 1 ou 2 passadas).
+
+// inteiro com sinal ou sem sinal -> uint64_t com a mesma ordem
+template <typename K>
+inline uint64_t orderedBits(K key) {
+    static_assert(std::is_integral<K>::value, "orderedBits needs an integer key");
+    if constexpr (std::is_signed<K>::value) {
+        return static_cast<uint64_t>(static_cast<int64_t>(key)) ^ (uint64_t(1) << 63);
+    } else {
+        return static_cast<uint64_t>(key);
+    }
+}
+
+// Reordena order de forma estável por keys[order[i]] (uma ordem anterior é mantida entre
+// chaves iguais, o que permite ordenar por várias chaves da última para a primeira).
+inline void radixSortBy(std::vector<size_t>& order, const std::vector<uint64_t>& keys) {
+    const size_t n = order.size();
+    std::vector<uint64_t> key(n), keyTmp(n);
+    std::vector<size_t> orderTmp(n);
+    for (size_t i = 0; i < n; ++i) {
+        key[i] = keys[order[i]];
+    }
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t counts[256] = {0};
+        for (size_t i = 0; i < n; ++i) {
+            ++counts[(key[i] >> shift) & 0xFF];
+        }
+        if (n == 0 || counts[(key[0] >> shift) & 0xFF] == n) {
+            continue;  // dígito igual em todas as chaves
+        }
+        size_t offset = 0;
+        for (size_t& count : counts) {
+            size_t c = count;
+            count = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            size_t pos = counts[(key[i] >> shift) & 0xFF]++;
+            keyTmp[pos] = key[i];
+            orderTmp[pos] = order[i];
+        }
+        key.swap(keyTmp);
+        order.swap(orderTmp);
+    }
+}
+
+// permutação estável que ordena keys
+inline std::vector<size_t> radixArgsort(const std::vector<uint64_t>& keys) {
+    std::vector<size_t> order(keys.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    radixSortBy(order, keys);
+    return order;
+}
+
+// ordena um vetor de inteiros in-place
+template <typename K>
+void radixSort(std::vector<K>& values) {
+    std::vector<uint64_t> keys(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        keys[i] = orderedBits(values[i]);
+    }
+    std::vector<size_t> order = radixArgsort(keys);
+    std::vector<K> sorted(values.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        sorted[i] = values[order[i]];
+    }
+    values.swap(sorted);
+}
+
+// resultado de uma agregação por chave inteira
+template <typename V>
+struct KeyAggregate {
+    int64_t key;
+    V sum;
+    size_t count;
+};
+
+namespace radix_detail {
+
+inline uint64_t hashKey(int64_t key) {
+    uint64_t h = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
+
+// agrega uma partição (cabe na cache) com uma tabela de endereçamento aberto
+template <typename V>
+void aggregatePartition(const int64_t* keys, const V* values, size_t n, std::vector<KeyAggregate<V>>& out) {
+    size_t capacity = 16;
+    while (capacity < 2 * n) capacity <<= 1;
+    std::vector<KeyAggregate<V>> slots(capacity);
+    std::vector<uint8_t> used(capacity, 0);
+    const size_t mask = capacity - 1;
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t slot = hashKey(keys[i]) & mask;
+        while (used[slot] && slots[slot].key != keys[i]) {
+            slot = (slot + 1) & mask;
+        }
+        if (!used[slot]) {
+            used[slot] = 1;
+            slots[slot] = {keys[i], V(), 0};
+        }
+        if (values) slots[slot].sum += values[i];
+        ++slots[slot].count;
+    }
+    for (size_t s = 0; s < capacity; ++s) {
+        if (used[s]) out.push_back(slots[s]);
+    }
+}
+
+template <typename V>
+std::vector<KeyAggregate<V>> aggregate(const std::vector<int64_t>& keys, const std::vector<V>* values) {
+    // partições de ~kPartitionRows linhas: a tabela de cada uma fica na cache
+    constexpr size_t kPartitionRows = 4096;
+    const size_t n = keys.size();
+    int bits = 0;
+    while (bits < 10 && (n >> bits) > kPartitionRows) ++bits;
+
+    std::vector<KeyAggregate<V>> result;
+    if (bits == 0) {
+        aggregatePartition(keys.data(), values ? values->data() : nullptr, n, result);
+        return result;
+    }
+
+    // particiona pelos bits altos do hash (histograma + distribuição), as tabelas usam os baixos
+    const size_t partitions = size_t(1) << bits;
+    const int shift = 64 - bits;
+    std::vector<size_t> start(partitions + 1, 0);
+    for (int64_t key : keys) {
+        ++start[(hashKey(key) >> shift) + 1];
+    }
+    for (size_t p = 0; p < partitions; ++p) {
+        start[p + 1] += start[p];
+    }
+    std::vector<size_t> next(start.begin(), start.end() - 1);
+    std::vector<int64_t> partKeys(n);
+    std::vector<V> partValues(values ? n : 0);
+    for (size_t i = 0; i < n; ++i) {
+        size_t pos = next[hashKey(keys[i]) >> shift]++;
+        partKeys[pos] = keys[i];
+        if (values) partValues[pos] = (*values)[i];
+    }
+
+    for (size_t p = 0; p < partitions; ++p) {
+        aggregatePartition(partKeys.data() + start[p], values ? partValues.data() + start[p] : nullptr,
+                           start[p + 1] - start[p], result);
+    }
+    return result;
+}
+
+} // namespace radix_detail
+
+// Soma (e contagem) de values por chave, particionando as chaves pelo hash antes de agregar.
+// Para muitos grupos distintos (por usuário, por voo) evita uma única tabela grande em que
+// cada acesso é um cache miss. A ordem dos grupos no resultado não é definida.
+template <typename V>
+std::vector<KeyAggregate<V>> radixAggregate(const std::vector<int64_t>& keys, const std::vector<V>& values) {
+    return radix_detail::aggregate(keys, &values);
+}
+
+// só a contagem por chave
+inline std::vector<KeyAggregate<int64_t>> radixCount(const std::vector<int64_t>& keys) {
+    return radix_detail::aggregate<int64_t>(keys, nullptr);
+}
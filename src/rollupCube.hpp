@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <unordered_map>
+#include <mutex>
+#include <algorithm>
+#include <utility>
+#include "dataframe.hpp"
+#include "decimal.hpp"
+
+// Dimensões do cubo de receita
+enum class CubeDimension { Day, PaymentMethod, UserCountry, SeatType, Destination };
+
+// Cubo de rollup: receita (em centavos) e número de reservas por célula dia × payment_method ×
+// user_country × seat_type × destination. Cada dimensão é codificada por dicionário, então uma
+// célula é uma chave de 5 inteiros. Os lotes entram com add/merge; qualquer agregação sobre um
+// subconjunto das dimensões (faturamento por dia, por método, por país, por assento, reservas
+// por destino, ou combinações como dia × método) sai de rollup sem reler as reservas.
+class RollupCube {
+public:
+    static constexpr size_t kDimensions = 5;
+    using Coordinates = std::array<std::string_view, kDimensions>;
+
+    struct Measures {
+        int64_t revenueCents = 0;
+        uint64_t reservations = 0;
+    };
+
+    // nome da coluna de cada dimensão nos DataFrames de rollup (os mesmos das tabelas do banco)
+    static const char* columnName(CubeDimension dimension) {
+        static const char* names[] = {"reservation_time", "payment_method", "user_country", "seat_type", "destination"};
+        return names[static_cast<size_t>(dimension)];
+    }
+
+    RollupCube() {}
+
+    // soma uma reserva (ou várias já agregadas) à célula das coordenadas
+    void add(const Coordinates& coordinates, int64_t revenueCents, uint64_t reservations = 1) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        insert(coordinates, revenueCents, reservations);
+    }
+
+    // soma count reservas sob um único lock (laço por linha de um lote): rowAt(i, coordinates,
+    // revenueCents) preenche as coordenadas e a receita da reserva i
+    template <typename RowFn>
+    void addRows(size_t count, RowFn&& rowAt) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Coordinates coordinates;
+        for (size_t i = 0; i < count; ++i) {
+            int64_t revenueCents = 0;
+            rowAt(i, coordinates, revenueCents);
+            insert(coordinates, revenueCents, 1);
+        }
+    }
+
+    // soma as células de other (ex.: cubo de uma partição no cubo do lote)
+    void merge(const RollupCube& other) {
+        if (&other == this) return;
+        std::scoped_lock lock(mutex_, other.mutex_);
+        // códigos de other -> códigos deste cubo
+        std::array<std::vector<uint32_t>, kDimensions> translate;
+        for (size_t d = 0; d < kDimensions; ++d) {
+            for (const std::string& value : other.dictionaries_[d].values) {
+                translate[d].push_back(dictionaries_[d].encode(value));
+            }
+        }
+        for (const auto& [otherKey, measures] : other.cells_) {
+            CellKey key;
+            for (size_t d = 0; d < kDimensions; ++d) {
+                key[d] = translate[d][otherKey[d]];
+            }
+            Measures& cell = cells_[key];
+            cell.revenueCents += measures.revenueCents;
+            cell.reservations += measures.reservations;
+        }
+    }
+
+    // Agrega as células nas dimensões de groupBy (as demais são somadas), só com as células
+    // em que cada dimensão de slice tem o valor dado. Resultado em ordem das chaves, com as
+    // colunas das dimensões, "price" (receita exata) e "reservation_count".
+    DataFrame<std::string> rollup(const std::vector<CubeDimension>& groupBy,
+                                  const std::vector<std::pair<CubeDimension, std::string>>& slice = {}) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::vector<std::pair<size_t, uint32_t>> sliceCodes;
+        bool empty = false;
+        for (const auto& [dimension, value] : slice) {
+            const Dictionary& dictionary = dictionaries_[static_cast<size_t>(dimension)];
+            auto it = dictionary.codes.find(value);
+            if (it == dictionary.codes.end()) {
+                empty = true;  // valor nunca visto: nenhuma célula no recorte
+                break;
+            }
+            sliceCodes.push_back({static_cast<size_t>(dimension), it->second});
+        }
+
+        std::unordered_map<CellKey, Measures, CellKeyHash> groups;
+        if (!empty) {
+            for (const auto& [key, measures] : cells_) {
+                bool inSlice = std::all_of(sliceCodes.begin(), sliceCodes.end(),
+                                           [&](const auto& code) { return key[code.first] == code.second; });
+                if (!inSlice) continue;
+                CellKey projected{};
+                for (size_t g = 0; g < groupBy.size(); ++g) {
+                    projected[g] = key[static_cast<size_t>(groupBy[g])];
+                }
+                Measures& group = groups[projected];
+                group.revenueCents += measures.revenueCents;
+                group.reservations += measures.reservations;
+            }
+        }
+
+        // ordena pelos valores das dimensões (datas ISO ordenam cronologicamente como texto)
+        std::vector<std::pair<std::vector<const std::string*>, Measures>> rows;
+        rows.reserve(groups.size());
+        for (const auto& [projected, measures] : groups) {
+            std::vector<const std::string*> names;
+            for (size_t g = 0; g < groupBy.size(); ++g) {
+                names.push_back(&dictionaries_[static_cast<size_t>(groupBy[g])].values[projected[g]]);
+            }
+            rows.push_back({std::move(names), measures});
+        }
+        std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+            return std::lexicographical_compare(a.first.begin(), a.first.end(), b.first.begin(), b.first.end(),
+                                                [](const std::string* x, const std::string* y) { return *x < *y; });
+        });
+
+        std::vector<std::string> columns;
+        for (CubeDimension dimension : groupBy) {
+            columns.push_back(columnName(dimension));
+        }
+        columns.push_back("price");
+        columns.push_back("reservation_count");
+        std::vector<Series<std::string>> series(columns.size());
+        for (const auto& [names, measures] : rows) {
+            for (size_t g = 0; g < names.size(); ++g) {
+                series[g].addElement(*names[g]);
+            }
+            series[groupBy.size()].addElement(formatDecimal(measures.revenueCents, 2));
+            series[groupBy.size() + 1].addElement(std::to_string(measures.reservations));
+        }
+        return DataFrame<std::string>(std::move(columns), std::move(series));
+    }
+
+    size_t numCells() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cells_.size();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cells_.clear();
+        for (Dictionary& dictionary : dictionaries_) {
+            dictionary = Dictionary();
+        }
+    }
+
+private:
+    using CellKey = std::array<uint32_t, kDimensions>;
+
+    // chamado com mutex_ já travado
+    void insert(const Coordinates& coordinates, int64_t revenueCents, uint64_t reservations) {
+        CellKey key;
+        for (size_t d = 0; d < kDimensions; ++d) {
+            key[d] = dictionaries_[d].encode(coordinates[d]);
+        }
+        Measures& cell = cells_[key];
+        cell.revenueCents += revenueCents;
+        cell.reservations += reservations;
+    }
+
+    struct CellKeyHash {
+        size_t operator()(const CellKey& key) const {
+            uint64_t h = 0;
+            for (uint32_t code : key) {
+                h = (h ^ code) * 0x9E3779B97F4A7C15ull;
+            }
+            return static_cast<size_t>(h ^ (h >> 32));
+        }
+    };
+
+    // valor <-> código de uma dimensão
+    struct Dictionary {
+        std::vector<std::string> values;
+        std::unordered_map<std::string, uint32_t> codes;
+
+        uint32_t encode(std::string_view value) {
+            // linhas vizinhas costumam repetir o valor (mesmo dia, mesmo método)
+            if (!values.empty() && values[last] == value) return last;
+            auto [it, inserted] = codes.try_emplace(std::string(value), static_cast<uint32_t>(values.size()));
+            if (inserted) values.emplace_back(value);
+            last = it->second;
+            return last;
+        }
+
+        uint32_t last = 0;
+    };
+
+    std::array<Dictionary, kDimensions> dictionaries_;
+    std::unordered_map<CellKey, Measures, CellKeyHash> cells_;
+    mutable std::mutex mutex_;
+};
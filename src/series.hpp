@@ -4,22 +4,126 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <atomic>
+#include "bitmap.hpp"
 
+// carimbo de versão único no processo: cada série criada, copiada ou modificada recebe um novo,
+// então uma estrutura derivada (zone map, estatísticas, chaves substitutas) nunca confunde o
+// conteúdo atual com outro que reaproveitou o mesmo buffer e o mesmo tamanho
+inline uint64_t nextSeriesVersion() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
 
 template <typename T>
 class Series {
 public:
     Series() {}
 
-    Series(std::vector<T> data) : data_(data) {}
+    Series(std::vector<T> data) : data_(std::move(data)) {}
 
-    ~Series() {
-        data_.clear();
+    // a cópia é outro conteúdo: carimbo novo
+    Series(const Series& other) : data_(other.data_), validity_(other.validity_) {}
+
+    // o movimento leva buffer e carimbo juntos; a origem, vazia, recebe um carimbo novo
+    Series(Series&& other) noexcept
+        : data_(std::move(other.data_)), version_(other.version_), validity_(std::move(other.validity_)) {
+        other.version_ = nextSeriesVersion();
+    }
+
+    Series& operator=(const Series& other) {
+        if (this != &other) {
+            data_ = other.data_;
+            validity_ = other.validity_;
+            version_ = nextSeriesVersion();
+        }
+        return *this;
+    }
+
+    Series& operator=(Series&& other) noexcept {
+        if (this != &other) {
+            data_ = std::move(other.data_);
+            validity_ = std::move(other.validity_);
+            version_ = other.version_;
+            other.version_ = nextSeriesVersion();
+        }
+        return *this;
     }
 
     // adicionar um elemento na série
     void addElement(const T& value) {
         data_.push_back(value);
+        if (hasValidity()) validity_.push_back(true);
+        version_ = nextSeriesVersion();
+    }
+
+    void addElement(T&& value) {
+        data_.push_back(std::move(value));
+        if (hasValidity()) validity_.push_back(true);
+        version_ = nextSeriesVersion();
+    }
+
+    // adicionar um valor ausente (guarda T() na posição e zera o bit de validade)
+    void addNull() {
+        ensureValidity();
+        data_.push_back(T());
+        validity_.push_back(false);
+        version_ = nextSeriesVersion();
+    }
+
+    void setNull(size_t index) {
+        if (index >= data_.size()) {
+            throw std::out_of_range("Index out of range.");
+        }
+        ensureValidity();
+        data_[index] = T();
+        validity_.reset(index);
+        version_ = nextSeriesVersion();
+    }
+
+    bool isNull(size_t index) const {
+        return hasValidity() && !validity_.test(index);
+    }
+
+    size_t nullCount() const {
+        return hasValidity() ? data_.size() - validity_.count() : 0;
+    }
+
+    bool hasNulls() const {
+        return nullCount() > 0;
+    }
+
+    // bit i = 1 se o valor i está presente; combinável com outras máscaras (&, |, ~)
+    Bitmap validMask() const {
+        return hasValidity() ? validity_ : Bitmap(data_.size(), true);
+    }
+
+    // reservar espaço para n elementos (evita realocações em inserções em sequência)
+    void reserve(size_t n) {
+        data_.reserve(n);
+    }
+
+    // acrescentar os elementos de outra série no fim desta (in-place)
+    void append(const Series<T>& other) {
+        appendValidity(other);
+        data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+        version_ = nextSeriesVersion();
+    }
+
+    void append(Series<T>&& other) {
+        appendValidity(other);
+        if (data_.empty()) {
+            data_ = std::move(other.data_);
+        } else {
+            data_.insert(data_.end(), std::make_move_iterator(other.data_.begin()),
+                         std::make_move_iterator(other.data_.end()));
+        }
+        other.data_.clear();
+        other.validity_ = Bitmap();
+        version_ = nextSeriesVersion();
     }
 
     // remover o último elemento da série
@@ -28,6 +132,8 @@ public:
             throw std::out_of_range("No elements to remove.");
         }
         data_.pop_back(); 
+        if (hasValidity()) validity_.pop_back();
+        version_ = nextSeriesVersion();
     }
     
     // remover um elemento pelo índice
@@ -36,6 +142,51 @@ public:
             throw std::out_of_range("Index out of range.");
         }
         data_.erase(data_.begin() + index);
+        if (hasValidity()) validity_.erase(index);
+        version_ = nextSeriesVersion();
+    }
+
+    // remover os n primeiros elementos de uma vez (um único deslocamento do vetor)
+    void removeFirst(size_t n) {
+        if (n > data_.size()) {
+            throw std::out_of_range("Index out of range.");
+        }
+        data_.erase(data_.begin(), data_.begin() + n);
+        if (hasValidity()) validity_ = validity_.slice(n, validity_.size());
+        version_ = nextSeriesVersion();
+    }
+
+    // cópia dos elementos em [start, end)
+    Series<T> slice(size_t start, size_t end) const {
+        if (start > end || end > data_.size()) {
+            throw std::out_of_range("Index out of range.");
+        }
+        Series<T> result(std::vector<T>(data_.begin() + start, data_.begin() + end));
+        if (hasValidity()) result.validity_ = validity_.slice(start, end);
+        return result;
+    }
+
+    // elementos nas posições selecionadas pela máscara (com seus nulos)
+    Series<T> gather(const Bitmap& mask) const {
+        Series<T> result(::gather(data_, mask));
+        if (hasValidity()) result.validity_ = validity_.gather(mask);
+        return result;
+    }
+
+    // elementos nas posições indicadas, nessa ordem (permutações de sort/topK)
+    Series<T> take(const std::vector<size_t>& indices) const {
+        std::vector<T> values;
+        values.reserve(indices.size());
+        for (size_t i : indices) {
+            values.push_back(data_[i]);
+        }
+        Series<T> result(std::move(values));
+        if (hasValidity()) {
+            for (size_t i : indices) {
+                result.validity_.push_back(validity_.test(i));
+            }
+        }
+        return result;
     }
 
     void updateElementAt(int index, const T& newValue) {
@@ -44,22 +195,20 @@ public:
         }
 
         data_[index] = newValue;  // Atualiza o valor na posição especificada
+        if (hasValidity()) validity_.set(index);
+        version_ = nextSeriesVersion();
     }
 
     static Series<T> createEmpty(int size, const T& defaultValue = T()) {
-        Series<T> series;
-        for (int i = 0; i < size; ++i) {
-            series.addElement(defaultValue);
-        }
-        return series;
+        return Series<T>(std::vector<T>(size, defaultValue));
     }
 
     // adicionar todos os elementos de outra série
     Series<T> appendSeries(const Series<T>& other) const {
-        Series<T> result = this->copy(); 
-        for (const T& value : other.data_) {
-            result.addElement(value);
-        }
+        Series<T> result;
+        result.reserve(size() + other.size());
+        result.append(*this);
+        result.append(other);
         return result;
     }
 
@@ -70,6 +219,16 @@ public:
         return data_[index];
     }
 
+    // acesso direto aos dados (somente leitura)
+    const std::vector<T>& values() const {
+        return data_;
+    }
+
+    // carimbo da última modificação (usado para invalidar estruturas derivadas, como zone maps)
+    uint64_t version() const {
+        return version_;
+    }
+
     // tamanho da série
     size_t size() const {
         return data_.size();
@@ -81,19 +240,21 @@ public:
             throw std::invalid_argument("Both series must have the same size");
         }
         std::vector<T> result;
+        result.reserve(size());
         for (size_t i = 0; i < this->size(); ++i) {
             result.push_back(data_[i] + other.data_[i]);
         }
-        return Series<T>(result);
+        return Series<T>(std::move(result));
     }
 
     // adicionar um valor escalar a cada elemento da série
     Series<T> addScalar(const T& scalar) const {
         std::vector<T> result;
+        result.reserve(size());
         for (const T& value : data_) {
             result.push_back(value + scalar);
         }
-        return Series<T>(result);
+        return Series<T>(std::move(result));
     }
 
     // printar os elementos da série
@@ -107,9 +268,31 @@ public:
 
     // criar uma cópia
     Series<T> copy() const {
-        return Series<T>(data_);
+        return *this;
     }
 
 private:
+    // o bitmap de validade só existe depois do primeiro nulo
+    bool hasValidity() const {
+        return validity_.size() != 0;
+    }
+
+    // passa a acompanhar a validade de cada valor (todos válidos até aqui)
+    void ensureValidity() {
+        if (!hasValidity()) {
+            validity_ = Bitmap(data_.size(), true);
+        }
+    }
+
+    void appendValidity(const Series<T>& other) {
+        if (!hasValidity() && !other.hasValidity()) {
+            return;
+        }
+        ensureValidity();
+        validity_.append(other.validMask());
+    }
+
     std::vector<T> data_;  // dados armazenados na série
+    uint64_t version_ = nextSeriesVersion(); // novo carimbo a cada modificação
+    Bitmap validity_;      // vazio enquanto não há nulos; depois, um bit por valor
 };
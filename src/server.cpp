@@ -4,12 +4,12 @@
 #include "event.grpc.pb.h"
 #include "database.h"
 #include "extractor.hpp"
+#include "dateTime.hpp"
 #include "etl.cpp"
 #include <string>
 #include <atomic>
 #include <thread>
 #include <iomanip>  // Para std::put_time
-#include <ctime>    // Para std::localtime
 
 using grpc::Server;
 using grpc::ServerBuilder;
@@ -19,13 +19,10 @@ using events::Event;
 using events::Ack;
 using events::EventService;
 
-// Função auxiliar para formatar timestamp
+// Função auxiliar para formatar timestamp (milissegundos desde 1970, mostrado em UTC);
+// aritmética inteira de dateTime.hpp no lugar de localtime/strftime, que não são thread-safe
 std::string formatTimestamp(int64_t timestamp) {
-    const time_t time = timestamp / 1000;
-    struct tm* timeinfo = std::localtime(&time);
-    char buffer[80];
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
-    return buffer;
+    return formatEpochSeconds(floorDiv(timestamp, 1000)) + " UTC";
 }
 
 class EventServiceImpl final : public EventService::Service {
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include "series.hpp"
+
+// Coluna de texto contígua: todos os valores ficam em um único buffer de bytes e
+// offsets[i]..offsets[i + 1] delimita o valor i. Acrescentar um valor não aloca nada por
+// valor (só o crescimento amortizado dos dois vetores), a leitura devolve std::string_view
+// e a coluna inteira pode ser gravada/lida como dois blocos de memória.
+class StringColumn {
+public:
+    StringColumn() : offsets_(1, 0) {}
+
+    // pré-aloca espaço para count valores somando bytes caracteres
+    void reserve(size_t count, size_t bytes) {
+        offsets_.reserve(count + 1);
+        bytes_.reserve(bytes);
+    }
+
+    void append(std::string_view value) {
+        bytes_.insert(bytes_.end(), value.begin(), value.end());
+        offsets_.push_back(bytes_.size());
+    }
+
+    // mesmo nome usado pelos contêineres da std, para código genérico de preenchimento
+    void emplace_back(std::string_view value = {}) {
+        append(value);
+    }
+
+    // acrescenta todos os valores de outra coluna (cópia em bloco dos bytes)
+    void append(const StringColumn& other) {
+        uint64_t base = bytes_.size();
+        bytes_.insert(bytes_.end(), other.bytes_.begin(), other.bytes_.end());
+        offsets_.reserve(offsets_.size() + other.size());
+        for (size_t i = 1; i < other.offsets_.size(); ++i) {
+            offsets_.push_back(base + other.offsets_[i]);
+        }
+    }
+
+    size_t size() const { return offsets_.size() - 1; }
+    bool empty() const { return size() == 0; }
+    size_t byteSize() const { return bytes_.size(); }
+
+    std::string_view operator[](size_t i) const {
+        return std::string_view(bytes_.data() + offsets_[i], static_cast<size_t>(offsets_[i + 1] - offsets_[i]));
+    }
+
+    std::string_view at(size_t i) const {
+        if (i >= size()) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    void clear() {
+        offsets_.assign(1, 0);
+        bytes_.clear();
+    }
+
+    // representação bruta (size() + 1 offsets e o buffer de bytes)
+    const std::vector<uint64_t>& offsets() const { return offsets_; }
+    const std::vector<char>& bytes() const { return bytes_; }
+
+    // conversões de/para a série de std::string usada pelo DataFrame
+    static StringColumn fromSeries(const Series<std::string>& series) {
+        StringColumn column;
+        const std::vector<std::string>& values = series.values();
+        size_t bytes = 0;
+        for (const auto& value : values) {
+            bytes += value.size();
+        }
+        column.reserve(values.size(), bytes);
+        for (const auto& value : values) {
+            column.append(value);
+        }
+        return column;
+    }
+
+    Series<std::string> toSeries() const {
+        std::vector<std::string> values;
+        values.reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            values.emplace_back((*this)[i]);
+        }
+        return Series<std::string>(std::move(values));
+    }
+
+private:
+    std::vector<uint64_t> offsets_;
+    std::vector<char> bytes_;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <stdexcept>
+#include "series.hpp"
+#include "dimensionLookup.hpp"
+
+// número do voo em "AAA-12" (ou "12"): os dígitos depois do primeiro '-', se houver.
+// Retorna -1 se não sobrar um número (vazio, letras, mais de 18 dígitos).
+inline int64_t parseFlightNumber(std::string_view flightId) {
+    size_t dash = flightId.find('-');
+    if (dash != std::string_view::npos) {
+        flightId.remove_prefix(dash + 1);
+    }
+    if (flightId.empty() || flightId.size() > 18) return -1;
+    int64_t value = 0;
+    for (char c : flightId) {
+        if (c < '0' || c > '9') return -1;
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+// Chave substituta inteira de uma coluna de ids em texto (flight_id "AAA-12" -> 12), calculada
+// em uma passada sobre a coluna e guardada no DataFrame ao lado dela (ver
+// DataFrame::surrogateKeys). Os joins dos enriquecedores usam os inteiros, sem substr, stoi
+// ou exceções por linha. Ids sem número (e nulos) ficam com kNoKey.
+class SurrogateKeyColumn {
+public:
+    static constexpr int64_t kNoKey = -1;
+
+    SurrogateKeyColumn() {}
+
+    explicit SurrogateKeyColumn(const Series<std::string>& series) {
+        const std::vector<std::string>& ids = series.values();
+        keys_.resize(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            keys_[i] = series.isNull(i) ? kNoKey : parseFlightNumber(ids[i]);
+        }
+        bind(series);
+    }
+
+    // chaves já calculadas (recorte ou seleção das chaves de outra coluna) para series
+    SurrogateKeyColumn(std::vector<int64_t> keys, const Series<std::string>& series) : keys_(std::move(keys)) {
+        if (keys_.size() != series.size()) {
+            throw std::invalid_argument("Surrogate keys and series must have the same size");
+        }
+        bind(series);
+    }
+
+    // as chaves continuam válidas enquanto a série não muda (mesmo buffer, tamanho e versão)
+    bool isFresh(const Series<std::string>& series) const {
+        return series.values().data() == data_ && series.size() == keys_.size() && series.version() == version_;
+    }
+
+    const std::vector<int64_t>& keys() const { return keys_; }
+    int64_t operator[](size_t row) const { return keys_[row]; }
+    size_t size() const { return keys_.size(); }
+
+    // chave -> linha (a última com a chave), para o lado da dimensão de um join
+    DimensionLookup<int> rowLookup() const {
+        std::vector<int64_t> keys;
+        std::vector<int> rows;
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (keys_[i] == kNoKey) continue;
+            keys.push_back(keys_[i]);
+            rows.push_back(static_cast<int>(i));
+        }
+        return DimensionLookup<int>::build(keys, std::move(rows));
+    }
+
+private:
+    void bind(const Series<std::string>& series) {
+        data_ = series.values().data();
+        version_ = series.version();
+    }
+
+    std::vector<int64_t> keys_;
+    const std::string* data_ = nullptr;
+    uint64_t version_ = 0;
+};
@@ -54,6 +54,11 @@ public:
         }
     }
 
+    // número de threads do pool
+    size_t size() const {
+        return workers.size();
+    }
+
     // Adiciona uma nova tarefa genérica ao pool
     template<class F, class... Args>
     auto addTask(F&& f, Args&&... args)
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <tuple>
+#include <cstdint>
+#include <charconv>
+#include <system_error>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include "dataframe.hpp"
+#include "bitmap.hpp"
+
+// Schema conhecido em tempo de compilação: cada coluna é uma tag com o tipo do valor e o
+// nome usado no DataFrame dinâmico. Ex.:
+//   struct price { using type = double; static constexpr const char* name = "price"; };
+//   using MySchema = Schema<flight_id, price>;
+template <typename... Columns>
+struct Schema {
+    static constexpr size_t size = sizeof...(Columns);
+};
+
+namespace typed_detail {
+
+// posição da tag Column na lista Columns... (erro de compilação se não pertencer ao schema)
+template <typename Column, typename... Columns>
+struct IndexOf;
+
+template <typename Column, typename... Rest>
+struct IndexOf<Column, Column, Rest...> : std::integral_constant<size_t, 0> {};
+
+template <typename Column, typename First, typename... Rest>
+struct IndexOf<Column, First, Rest...> : std::integral_constant<size_t, 1 + IndexOf<Column, Rest...>::value> {};
+
+template <typename Column>
+struct IndexOf<Column> {
+    static_assert(sizeof(Column) == 0, "Column is not part of the schema");
+};
+
+// conversão texto <-> tipo da coluna, usada só na fronteira com o DataFrame<std::string>.
+// O texto inteiro tem que ser um número do tipo (sinal '+' opcional); senão invalid_argument,
+// em vez de virar 0 como com strtod/strtol
+inline void parseValue(const std::string& text, std::string& out) { out = text; }
+
+template <typename V>
+void parseValue(const std::string& text, V& out) {
+    static_assert(std::is_arithmetic<V>::value, "Unsupported column type");
+    const char* begin = text.data();
+    const char* end = text.data() + text.size();
+    if (begin != end && *begin == '+') ++begin;
+    auto result = std::from_chars(begin, end, out);
+    if (begin == end || result.ec != std::errc() || result.ptr != end) {
+        throw std::invalid_argument("Invalid number: " + text);
+    }
+}
+
+inline std::string formatValue(const std::string& value) { return value; }
+template <typename V>
+std::string formatValue(V value) { return std::to_string(value); }
+
+} // namespace typed_detail
+
+// DataFrame com schema estático e armazenamento em struct-of-arrays: uma std::vector por
+// coluna, com o tipo da coluna. O acesso é por tag (frame.col<price>()), resolvido em tempo
+// de compilação para a vector certa, então um laço sobre uma coluna é um laço direto sobre
+// o array, sem busca por nome, sem conversão de texto e sem Series<T> intermediária.
+// fromDataFrame/toDataFrame convertem de/para o DataFrame<std::string> dinâmico.
+template <typename S>
+class TypedFrame;
+
+template <typename... Columns>
+class TypedFrame<Schema<Columns...>> {
+public:
+    template <typename Column>
+    using value_type = typename Column::type;
+
+    TypedFrame() {}
+
+    size_t numRows() const { return std::get<0>(data_).size(); }
+    bool empty() const { return numRows() == 0; }
+
+    static std::vector<std::string> columnNames() {
+        return {Columns::name...};
+    }
+
+    // vector da coluna Column
+    template <typename Column>
+    std::vector<value_type<Column>>& col() {
+        return std::get<typed_detail::IndexOf<Column, Columns...>::value>(data_);
+    }
+
+    template <typename Column>
+    const std::vector<value_type<Column>>& col() const {
+        return std::get<typed_detail::IndexOf<Column, Columns...>::value>(data_);
+    }
+
+    void reserve(size_t rows) {
+        forEachColumn([rows](auto& values, const char*) { values.reserve(rows); });
+    }
+
+    // uma linha, com os valores na ordem do schema
+    void addRow(typename Columns::type... values) {
+        addRow(std::index_sequence_for<Columns...>(), std::move(values)...);
+    }
+
+    void append(const TypedFrame& other) {
+        appendColumns(other, std::index_sequence_for<Columns...>());
+    }
+
+    // linhas selecionadas por mask, coluna a coluna
+    TypedFrame filter(const Bitmap& mask) const {
+        if (mask.size() != numRows()) {
+            throw std::invalid_argument("Mask size must match the number of rows");
+        }
+        TypedFrame result;
+        gatherColumns(result, mask, std::index_sequence_for<Columns...>());
+        return result;
+    }
+
+    // Converte as colunas do schema de um DataFrame<std::string> (os nomes são buscados uma
+    // vez por coluna). O TypedFrame não tem nulos: uma coluna com nulos ou com texto que não
+    // é do tipo da coluna gera invalid_argument.
+    static TypedFrame fromDataFrame(const DataFrame<std::string>& df) {
+        TypedFrame frame;
+        size_t rows = static_cast<size_t>(df.numRows());
+        frame.forEachColumn([&](auto& values, const char* name) {
+            if (!df.columnExists(name)) {
+                throw std::invalid_argument(std::string("Column does not exist: ") + name);
+            }
+            if (df[name].hasNulls()) {
+                throw std::invalid_argument(std::string("Column has null values: ") + name);
+            }
+            const std::vector<std::string>& source = df.values(df.column(name));
+            values.resize(rows);
+            for (size_t i = 0; i < rows; ++i) {
+                typed_detail::parseValue(source[i], values[i]);
+            }
+        });
+        return frame;
+    }
+
+    DataFrame<std::string> toDataFrame() const {
+        std::vector<Series<std::string>> series;
+        series.reserve(sizeof...(Columns));
+        forEachColumn([&](const auto& values, const char*) {
+            std::vector<std::string> text;
+            text.reserve(values.size());
+            for (const auto& value : values) {
+                text.push_back(typed_detail::formatValue(value));
+            }
+            series.emplace_back(std::move(text));
+        });
+        return DataFrame<std::string>(columnNames(), std::move(series));
+    }
+
+private:
+    // chama f(vector, nome) para cada coluna, na ordem do schema
+    template <typename F>
+    void forEachColumn(F&& f) {
+        size_t i = 0;
+        const char* names[] = {Columns::name...};
+        std::apply([&](auto&... values) { (f(values, names[i++]), ...); }, data_);
+    }
+
+    template <typename F>
+    void forEachColumn(F&& f) const {
+        size_t i = 0;
+        const char* names[] = {Columns::name...};
+        std::apply([&](const auto&... values) { (f(values, names[i++]), ...); }, data_);
+    }
+
+    template <size_t... I>
+    void addRow(std::index_sequence<I...>, typename Columns::type... values) {
+        (std::get<I>(data_).push_back(std::move(values)), ...);
+    }
+
+    template <size_t... I>
+    void appendColumns(const TypedFrame& other, std::index_sequence<I...>) {
+        (std::get<I>(data_).insert(std::get<I>(data_).end(), std::get<I>(other.data_).begin(),
+                                   std::get<I>(other.data_).end()), ...);
+    }
+
+    template <size_t... I>
+    void gatherColumns(TypedFrame& result, const Bitmap& mask, std::index_sequence<I...>) const {
+        ((std::get<I>(result.data_) = gather(std::get<I>(data_), mask)), ...);
+    }
+
+    std::tuple<std::vector<typename Columns::type>...> data_;
+};
+
+// Schema das reservas (eventos gRPC, mock e tabela MockData)
+namespace reservation {
+struct flight_id        { using type = std::string; static constexpr const char* name = "flight_id"; };
+struct seat             { using type = std::string; static constexpr const char* name = "seat"; };
+struct user_id          { using type = std::string; static constexpr const char* name = "user_id"; };
+struct customer_name    { using type = std::string; static constexpr const char* name = "customer_name"; };
+struct status           { using type = std::string; static constexpr const char* name = "status"; };
+struct payment_method   { using type = std::string; static constexpr const char* name = "payment_method"; };
+struct reservation_time { using type = std::string; static constexpr const char* name = "reservation_time"; };
+struct price            { using type = double;      static constexpr const char* name = "price"; };
+struct timestamp        { using type = int64_t;     static constexpr const char* name = "timestamp"; };
+
+using ReservationSchema = Schema<flight_id, seat, user_id, customer_name, status, payment_method,
+                                 reservation_time, price, timestamp>;
+} // namespace reservation
+
+using ReservationFrame = TypedFrame<reservation::ReservationSchema>;
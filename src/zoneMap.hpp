@@ -0,0 +1,140 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include "predicate.hpp"
+
+// Zone map: min/max por bloco de linhas de uma coluna ordenável (datas, timestamps, preços).
+// Consultas por faixa pulam os blocos cuja faixa [min, max] não cruza [lo, hi].
+//
+// Colunas de texto são comparadas numericamente quando todos os valores e os limites são
+// números; caso contrário a comparação é lexicográfica (datas ISO-8601 ordenam certo assim).
+template <typename T>
+class ZoneMap {
+public:
+    static constexpr size_t kDefaultBlockRows = 4096;
+
+    ZoneMap() {}
+
+    ZoneMap(const std::vector<T>& values, uint64_t version, size_t blockRows = kDefaultBlockRows)
+        : blockRows_(blockRows == 0 ? kDefaultBlockRows : blockRows), rows_(values.size()),
+          data_(values.data()), version_(version) {
+        numeric_ = detectNumeric(values);
+
+        for (size_t start = 0; start < values.size(); start += blockRows_) {
+            size_t end = std::min(values.size(), start + blockRows_);
+            if (numeric_) {
+                double lo = toNumber(values[start]), hi = lo;
+                for (size_t i = start + 1; i < end; ++i) {
+                    double v = toNumber(values[i]);
+                    lo = std::min(lo, v);
+                    hi = std::max(hi, v);
+                }
+                minNumbers_.push_back(lo);
+                maxNumbers_.push_back(hi);
+            } else {
+                const T* lo = &values[start];
+                const T* hi = lo;
+                for (size_t i = start + 1; i < end; ++i) {
+                    if (values[i] < *lo) lo = &values[i];
+                    if (*hi < values[i]) hi = &values[i];
+                }
+                mins_.push_back(*lo);
+                maxs_.push_back(*hi);
+            }
+        }
+    }
+
+    size_t blockRows() const { return blockRows_; }
+    size_t numBlocks() const { return numeric_ ? minNumbers_.size() : mins_.size(); }
+
+    // o zone map continua válido enquanto a série não muda (mesmo buffer, tamanho e versão)
+    bool isFresh(const std::vector<T>& values, uint64_t version) const {
+        return values.data() == data_ && values.size() == rows_ && version == version_;
+    }
+
+    // true se o bloco pode conter algum valor em [lo, hi]
+    bool blockMayMatch(size_t block, const T& lo, const T& hi) const {
+        double loNumber, hiNumber;
+        if (numeric_) {
+            if (!boundsAsNumbers(lo, hi, loNumber, hiNumber)) {
+                return true;  // limites não numéricos: sem como podar
+            }
+            return !(maxNumbers_[block] < loNumber || hiNumber < minNumbers_[block]);
+        }
+        return !(maxs_[block] < lo || hi < mins_[block]);
+    }
+
+    // comparação linha a linha com a mesma semântica usada para podar os blocos
+    bool inRange(const T& value, const T& lo, const T& hi) const {
+        double loNumber, hiNumber;
+        if (numeric_ && boundsAsNumbers(lo, hi, loNumber, hiNumber)) {
+            double v = toNumber(value);
+            return loNumber <= v && v <= hiNumber;
+        }
+        return !(value < lo) && !(hi < value);
+    }
+
+    // chama f(begin, end) para cada faixa de linhas cujo bloco pode conter [lo, hi]
+    template <typename F>
+    void forEachCandidateBlock(const T& lo, const T& hi, F&& f) const {
+        for (size_t block = 0; block < numBlocks(); ++block) {
+            if (blockMayMatch(block, lo, hi)) {
+                size_t begin = block * blockRows_;
+                f(begin, std::min(rows_, begin + blockRows_));
+            }
+        }
+    }
+
+private:
+    static bool detectNumeric(const std::vector<T>& values) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            return true;
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            double number;
+            for (const auto& value : values) {
+                if (!ColumnPredicate::parseNumber(value, number)) {
+                    return false;
+                }
+            }
+            return !values.empty();
+        } else {
+            return false;
+        }
+    }
+
+    static double toNumber(const T& value) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            return static_cast<double>(value);
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            double number = 0.0;
+            ColumnPredicate::parseNumber(value, number);
+            return number;
+        } else {
+            return 0.0;
+        }
+    }
+
+    static bool boundsAsNumbers(const T& lo, const T& hi, double& loNumber, double& hiNumber) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            loNumber = static_cast<double>(lo);
+            hiNumber = static_cast<double>(hi);
+            return true;
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            return ColumnPredicate::parseNumber(lo, loNumber) && ColumnPredicate::parseNumber(hi, hiNumber);
+        } else {
+            return false;
+        }
+    }
+
+    size_t blockRows_ = kDefaultBlockRows;
+    size_t rows_ = 0;
+    const T* data_ = nullptr;
+    uint64_t version_ = 0;
+    bool numeric_ = false;
+    std::vector<T> mins_, maxs_;                   // modo lexicográfico / genérico
+    std::vector<double> minNumbers_, maxNumbers_;  // modo numérico
+};
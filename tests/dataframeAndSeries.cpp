@@ -2,6 +2,11 @@
 #include <vector>
 #include "../src/series.hpp" 
 #include "../src/dataframe.hpp" 
+#include "../src/chunkedDataFrame.hpp"
+#include "../src/typedFrame.hpp"
+#include "../src/lazyFrame.hpp"
+#include "../src/dimensionLookup.hpp"
+#include "../src/rollupCube.hpp"
 
 // Função de teste para a classe Series
 void testSeries() {
@@ -27,6 +32,23 @@ void testSeries() {
 
     // Testando acesso por índice
     std::cout << "Elemento na posição 3 de s1: " << s1[3] << std::endl;  // Esperado: 4
+
+    // Valores nulos: marcados no bitmap de validade e ignorados nas agregações
+    Series<int> withNulls({1, 2});
+    withNulls.addNull();
+    withNulls.addElement(4);
+    std::cout << "Nulos em withNulls: " << withNulls.nullCount() << std::endl;  // Esperado: 1
+    DataFrame<int> nullDf({"V"}, {withNulls});
+    std::cout << "Soma ignorando nulos: " << nullDf.sum("V") << std::endl;     // Esperado: 7
+    std::cout << "Média ignorando nulos: " << nullDf.mean("V") << std::endl;   // Esperado: 2
+    Series<int> allNull;
+    allNull.addNull();
+    DataFrame<int> allNullDf({"V"}, {allNull});
+    try {
+        allNullDf.mean("V");
+    } catch (const std::out_of_range& e) {
+        std::cout << "Média de coluna toda nula: " << e.what() << std::endl;  // Esperado: Column has no values: V
+    }
 }
 
 // Função de teste para a classe DataFrame
@@ -68,6 +90,44 @@ void testDataFrame() {
     std::cout << "\nDataFrame concatenado (df2 + df):" << std::endl;
     df3.print();
 
+    // Append in-place (move) e DataFrameBuilder
+    DataFrame<int> merged;
+    merged.append(df.copy());
+    merged.append(std::move(df2));
+    std::cout << "\nDataFrame após append(df) e append(df2): " << merged.numRows() << " linhas" << std::endl; // Esperado: 8
+
+    DataFrameBuilder<int> builder({"X", "Y"}, 2);
+    builder.addRow({1, 2});
+    builder.addRow({3, 4});
+    DataFrame<int> built = builder.build();
+    std::cout << "\nDataFrame montado com DataFrameBuilder:" << std::endl;
+    built.print();
+
+    // Consumo FIFO em lotes: retirar da frente sem deslocar as colunas
+    ChunkedDataFrame<int> stream;
+    stream.append(df.copy());
+    stream.append(df.copy());
+    DataFrame<int> front = stream.popFront(3);
+    std::cout << "\nPrimeiras 3 linhas retiradas do ChunkedDataFrame:" << std::endl;
+    front.print();
+    std::cout << "Linhas restantes: " << stream.numRows() << std::endl; // Esperado: 5
+
+    // Acesso por handle: sem busca de nome, mas com as mesmas checagens de linha da versão por nome
+    ColumnHandle handleB = df.column("B");
+    std::cout << "\nB[1] por handle: " << df.getValue(handleB, 1);  // Esperado: 6
+    try {
+        df.getValue(handleB, df.numRows());
+    } catch (const std::out_of_range& e) {
+        std::cout << ", linha fora do intervalo: " << e.what() << std::endl;  // Esperado: Row index out of range.
+    }
+
+    // Zone map refeito quando a coluna é reatribuída (mesmo tamanho, mesmo buffer)
+    DataFrame<int> ranged({"K"}, {Series<int>({7, 8, 9})});
+    std::cout << "\nLinhas com K em [2, 3]: " << ranged.filterRange("K", 2, 3).numRows();  // Esperado: 0
+    Series<int> replacement({1, 2, 3});
+    ranged["K"] = replacement;  // cópia: reaproveita o buffer da coluna
+    std::cout << ", após reatribuir K: " << ranged.filterRange("K", 2, 3).numRows() << std::endl;  // Esperado: 2
+
     // Testando a função deleteLine
     std::cout << "\nTestando deleteLine" << std::endl;
     df.deleteLine(2);  // Remover a linha [3, 7, 11, 15]
@@ -84,12 +144,149 @@ void testDataFrame() {
     DataFrame<int> filteredDF = df.filter("B", ">", 5);
     std::cout << "\nDataFrame após filtro (B > 5):" << std::endl;
     filteredDF.print();
+
+    // Filtro com várias condições, avaliado em uma única passada: B > 5 || (A == 1 && D != 0)
+    DataFrame<int> multiDF = df.filter(FilterExpr<int>::where("B", ">", 5) ||
+                                       (FilterExpr<int>::where("A", "==", 1) && FilterExpr<int>::where("D", "!=", 0)));
+    std::cout << "\nDataFrame após filtro (B > 5 || (A == 1 && D != 0)):" << std::endl;
+    multiDF.print();
+
+    // Máscaras compactadas combinadas: B > 5 && !(A == 2)
+    Bitmap mask = df.mask(FilterExpr<int>::where("B", ">", 5)) & ~df.mask(FilterExpr<int>::where("A", "==", 2));
+    std::cout << "\nLinhas selecionadas pela máscara (B > 5 && !(A == 2)): " << mask.count() << std::endl; // Esperado: 0
+    df.filter(mask).print();
+
+    // Plano preguiçoso: filtro e map fundidos, materializados só no collect()
+    DataFrame<int> lazyDF = LazyFrame<int>(df.copy())
+        .filter("B", ">", 5)
+        .map("C", [](const int& c) { return c * 10; })
+        .select({"A", "C"})
+        .collect();
+    std::cout << "\nLazyFrame (B > 5, C * 10, colunas A e C):" << std::endl;
+    lazyDF.print();
+
+    // Ordenação estável por várias chaves e top-K
+    DataFrame<int> unsorted({"K", "V"}, {Series<int>({2, 1, 2, 1}), Series<int>({10, 20, 30, 40})});
+    std::cout << "\nDataFrame ordenado por K crescente e V decrescente:" << std::endl;
+    unsorted.sortBy({"K", "V"}, {true, false}).print();  // Esperado: (1,40) (1,20) (2,30) (2,10)
+    std::cout << "\nTop 2 por V:" << std::endl;
+    unsorted.topK("V", 2).print();  // Esperado: 40, 30
+
+    // Radix sort e agregação particionada para chaves inteiras
+    std::vector<int> radixValues = {42, -7, 0, 42, 3};
+    radixSort(radixValues);
+    std::cout << "\nradixSort:";
+    for (int value : radixValues) std::cout << " " << value;  // Esperado: -7 0 3 42 42
+    std::cout << std::endl;
+    std::cout << "Grupos distintos em radixCount: " << radixCount({5, 9, 5, 5, 9, 1}).size() << std::endl;  // Esperado: 3
+
+    // Estatísticas de coluna e estratégia de agregação escolhida por elas
+    DataFrame<std::string> payments({"payment_method", "price"},
+                                    {Series<std::string>({"pix", "card", "pix"}), Series<std::string>({"10", "20", "5"})});
+    std::cout << "\nNDV estimado de payment_method: " << payments.stats("payment_method").distinctEstimate() << std::endl;  // Esperado: 2
+    std::cout << "Agregação por dicionário pequeno: "
+              << (chooseAggregation(payments.stats("payment_method")) == AggregationStrategy::SmallDictionary) << std::endl;  // Esperado: 1
+    payments.groupby("payment_method", "price").print();  // Esperado: card 20, pix 15
+
+    // Tabelas de dimensão: ids inteiros densos indexam um vetor; chave composta (voo, assento)
+    auto countries = DimensionLookup<std::string>::build({"1", "2", "3"}, {"Brasil", "Chile", "Peru"});
+    std::cout << "\nPaís do usuário 2: " << *countries.find(std::string_view("2"))
+              << ", busca densa: " << countries.isDense() << std::endl;  // Esperado: Chile, 1
+    auto seats = CompositeLookup<std::string>::build({"7", "7"}, {"A1", "B2"}, {"Executiva", "Primeira"});
+    std::cout << "Classe do assento (7, B2): " << *seats.find(7, "B2")
+              << ", (8, A1) encontrado: " << (seats.find(8, "A1") != nullptr) << std::endl;  // Esperado: Primeira, 0
+
+    // Chave substituta inteira de flight_id, em cache no DataFrame e levada pelas partições
+    DataFrame<std::string> orders({"flight_id"}, {Series<std::string>({"AAA-12", "7", "sem-id", "AAA-3"})});
+    const SurrogateKeyColumn& flightKeys = orders.surrogateKeys("flight_id");
+    std::cout << "Números de voo: " << flightKeys[0] << " " << flightKeys[1] << " " << flightKeys[2]
+              << std::endl;  // Esperado: 12 7 -1
+    std::cout << "Chaves na partição: " << (orders.extractLines(2, 4).cachedSurrogateKeys("flight_id") != nullptr)
+              << std::endl;  // Esperado: 1
+
+    // Datas ISO-8601 como inteiros: receita por dia agrupada por dias desde 1970
+    DataFrame<std::string> sales({"reservation_time", "price"},
+                                 {Series<std::string>({"2025-01-02T23:59:59", "2025-01-01T08:00:00", "2025-01-02"}),
+                                  Series<std::string>({"10", "20", "5"})});
+    std::cout << "\nReceita por dia:" << std::endl;
+    sales.groupbyTime("reservation_time", "price").print();  // Esperado: 2025-01-01 20, 2025-01-02 15
+    DataFrame<std::string> messy({"reservation_time", "price"},
+                                 {Series<std::string>({"2025-01-01", "2025-01-01", "2025-01-02"}),
+                                  Series<std::string>({"1e1", "abc", "2.5"})});
+    messy.groupbyTime("reservation_time", "price").print();  // Esperado: 2025-01-01 10.000000, 2025-01-02 2.500000
+
+    // Preços em ponto fixo: soma exata em inteiros (0.1 + 0.2 não vira 0.30000000000000004)
+    DataFrame<std::string> cents({"payment_method", "price"},
+                                 {Series<std::string>({"pix", "pix", "card"}), Series<std::string>({"0.10", "0.20", "19.99"})});
+    std::cout << "\nSoma exata por método:" << std::endl;
+    cents.groupby("payment_method", "price").print();  // Esperado: card 19.99, pix 0.30
+
+    // Soma que não cabe em int64 na escala comum (6 casas): volta para double em vez de dar a volta
+    DataFrame<std::string> huge({"payment_method", "price"},
+                                {Series<std::string>({"pix", "pix", "pix"}),
+                                 Series<std::string>({"9000000000000.5", "9000000000000.5", "0.000001"})});
+    std::cout << "\nSoma grande por método:" << std::endl;
+    huge.groupby("payment_method", "price").print();  // Esperado: pix 18000000000001.000000
+
+    // Cubo de rollup: qualquer combinação de dimensões sai das mesmas células
+    RollupCube cube;
+    cube.add({"2025-01-01", "pix", "Brasil", "Econômica", "Lima"}, 1000);
+    cube.add({"2025-01-01", "card", "Chile", "Executiva", "Lima"}, 2550);
+    cube.add({"2025-01-02", "pix", "Brasil", "Econômica", "Quito"}, 500);
+    std::cout << "\nReceita por método no cubo:" << std::endl;
+    cube.rollup({CubeDimension::PaymentMethod}).print();  // Esperado: card 25.50 1, pix 15.00 2
+    std::cout << "Reservas para Lima em 2025-01-01: "
+              << cube.rollup({CubeDimension::Destination}, {{CubeDimension::Day, "2025-01-01"}}).getValue("reservation_count", 0)
+              << std::endl;  // Esperado: 2
+
+    // lote inteiro sob um só lock: mesmas células que add linha a linha
+    RollupCube batch;
+    batch.addRows(2, [](size_t i, RollupCube::Coordinates& coordinates, int64_t& cents) {
+        coordinates = {"2025-01-01", i == 0 ? "pix" : "card", "Brasil", "Econômica", "Lima"};
+        cents = 1000;
+    });
+    std::cout << "Células do lote: " << batch.numCells() << std::endl;  // Esperado: 2
+}
+
+// Função de teste para o TypedFrame (schema das reservas)
+void testTypedFrame() {
+    std::cout << "\nTestando TypedFrame" << std::endl;
+
+    ReservationFrame frame;
+    frame.addRow("AAA-1", "A1", "10", "Ana", "confirmed", "pix", "2025-01-01", 100.5, 1735700000);
+    frame.addRow("AAA-2", "B2", "11", "Bia", "pending", "card", "2025-01-02", 50.0, 1735800000);
+
+    double confirmed = 0.0;
+    const auto& status = frame.col<reservation::status>();
+    const auto& price = frame.col<reservation::price>();
+    for (size_t i = 0; i < frame.numRows(); ++i) {
+        if (status[i] == "confirmed") confirmed += price[i];
+    }
+    std::cout << "Receita confirmada: " << confirmed << std::endl;  // Esperado: 100.5
+
+    // Ida e volta pelo DataFrame dinâmico
+    DataFrame<std::string> dynamic = frame.toDataFrame();
+    ReservationFrame back = ReservationFrame::fromDataFrame(dynamic);
+    std::cout << "Timestamp da segunda linha: " << back.col<reservation::timestamp>()[1] << std::endl;  // Esperado: 1735800000
+
+    // Texto que não é número e nulos são rejeitados em vez de virar 0
+    for (bool asNull : {false, true}) {
+        DataFrame<std::string> bad = frame.toDataFrame();
+        if (asNull) bad["price"].setNull(0);
+        else bad.updateValue("price", 0, "abc");
+        try {
+            ReservationFrame::fromDataFrame(bad);
+        } catch (const std::invalid_argument& e) {
+            std::cout << "Rejeitado: " << e.what() << std::endl;  // Esperado: Invalid number: abc, Column has null values: price
+        }
+    }
 }
 
 
 int main() {
     testSeries();
     testDataFrame();
+    testTypedFrame();
 
     return 0;
 }
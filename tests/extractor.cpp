@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <cstdio>
 #include "../src/extractor.hpp"
 #include "../src/dataframe.hpp"
 #include "../src/series.hpp"
@@ -63,11 +64,11 @@ void testSqliteExtractor() {
     // Criar instância do extractor
     Extractor extractor;
 
-    // Definir a query para extrair os dados
-    std::string query = "SELECT * FROM flight_orders;";
+    // Definir a tabela de onde extrair os dados
+    std::string tableName = "flight_orders";
 
     // Usar a função extractFromSqlite para extrair os dados
-    DataFrame<std::string> df = extractor.extractFromSqlite(dbPath, query);
+    DataFrame<std::string> df = extractor.extractFromSqlite(dbPath, tableName);
 
     // Imprimir o DataFrame resultante
     std::cout << "\nDataFrame extraído do SQLite:" << std::endl;
@@ -76,6 +77,25 @@ void testSqliteExtractor() {
     std::cout << "=== Fim do teste ===" << std::endl;
 }
 
+// Predicado numérico numa coluna TEXT: comparado como número, como em ColumnPredicate::matches()
+void testSqliteNumericPredicate() {
+    std::cout << "=== Testando predicado numérico no SQLite ===" << std::endl;
+
+    std::string dbPath = "pushdown.db";
+    sqlite3* db;
+    sqlite3_open(dbPath.c_str(), &db);
+    sqlite3_exec(db, "CREATE TABLE prices (name TEXT, price TEXT);"
+                     "INSERT INTO prices VALUES ('a', '99.5'), ('b', '100'), ('c', '150');", 0, 0, nullptr);
+    sqlite3_close(db);
+
+    Extractor extractor;
+    DataFrame<std::string> df = extractor.extractFromSqlite(dbPath, "prices", {"name"}, {ColumnPredicate("price", ">", "100")});
+    std::cout << "Linhas: " << df.numRows() << ", colunas: " << df.getColumns().size() << ", name = " << df.getValue("name", 0) << std::endl;  // Esperado: 1, 1, c
+
+    std::remove(dbPath.c_str());
+    std::cout << "=== Fim do teste ===" << std::endl;
+}
+
 void testCsvExtractor() {
     std::cout << "=== Testando Extractor de CSV ===" << std::endl;
 
@@ -95,9 +115,126 @@ void testCsvExtractor() {
     std::cout << "=== Fim do teste ===" << std::endl;
 }
 
+void testCsvStringColumns() {
+    std::cout << "=== Testando colunas de texto contíguas ===" << std::endl;
+
+    Extractor extractor;
+    auto columns = extractor.extractStringColumnsFromCsv("../generator/testData.csv");
+
+    for (const auto& [name, column] : columns) {
+        std::cout << name << " (" << column.size() << " valores, " << column.byteSize() << " bytes):";
+        for (size_t i = 0; i < column.size(); ++i) {
+            std::cout << " [" << column[i] << "]";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "=== Fim do teste ===" << std::endl;
+}
+
+void testCsvParallelLiteralQuote() {
+    std::cout << "=== Testando CSV paralelo com aspas literais ===" << std::endl;
+
+    // aspas no meio de um campo sem aspas são texto; não podem desalinhar as divisões paralelas
+    std::string filePath = "literalQuote.csv";
+    {
+        std::ofstream file(filePath, std::ios::binary);
+        file << "product,price\n";
+        for (int i = 0; i < 40; ++i) {
+            file << (i % 3 == 0 ? "TV 5\" screen" : (i % 3 == 1 ? "\"cabo, 2m\"" : "mouse")) << "," << i << (i % 2 ? "\r\n" : "\r");
+        }
+    }
+
+    Extractor extractor;
+    DataFrame<std::string> serial = extractor.extractFromCsv(filePath);
+    bool same = true;
+    for (int threads : {2, 3, 4, 7}) {
+        DataFrame<std::string> parallel = extractor.extractFromCsvParallel(filePath, threads);
+        same = same && parallel.numRows() == serial.numRows();
+        for (int i = 0; same && i < serial.numRows(); ++i) {
+            same = parallel.getValue("product", i) == serial.getValue("product", i) &&
+                   parallel.getValue("price", i) == serial.getValue("price", i);
+        }
+    }
+    std::cout << "Linhas: " << serial.numRows() << ", paralelo igual ao sequencial: " << same << std::endl;  // Esperado: 40, 1
+
+    std::remove(filePath.c_str());
+    std::cout << "=== Fim do teste ===" << std::endl;
+}
+
+void testJsonTrailingComma() {
+    std::cout << "=== Testando JSON malformado ===" << std::endl;
+
+    // vírgula sem elemento depois (ou antes) rejeita o arquivo inteiro, sem carga parcial
+    Extractor extractor;
+    std::string filePath = "malformed.json";
+    for (const char* content : {"[{\"id\": \"1\"},]", "[,{\"id\": \"1\"}]"}) {
+        {
+            std::ofstream file(filePath);
+            file << content;
+        }
+        Queue<int, DataFrame<std::string>> partitions(1);
+        bool rejected = false;
+        try {
+            extractor.extractFromJsonPartitioned(filePath, 1, partitions, {"id"});
+        } catch (const std::exception& e) {
+            rejected = true;
+        }
+        std::cout << content << " rejeitado: " << rejected << std::endl;  // Esperado: 1
+    }
+
+    // registro inválido numa partição: as outras partições também não entram na fila
+    {
+        std::ofstream file(filePath);
+        file << "[{\"id\": \"1\"}, {\"id\": }]";
+    }
+    Queue<int, DataFrame<std::string>> partitions(3);
+    try {
+        extractor.extractFromJsonPartitioned(filePath, 2, partitions, {"id"});
+    } catch (const std::exception& e) {
+    }
+    partitions.enQueue({-1, DataFrame<std::string>()});
+    std::cout << "Primeiro item da fila: " << partitions.deQueue().first << std::endl;  // Esperado: -1
+
+    std::remove(filePath.c_str());
+    std::cout << "=== Fim do teste ===" << std::endl;
+}
+
+void testColumnarRoundTrip() {
+    std::cout << "=== Testando formato colunar ===" << std::endl;
+
+    Extractor extractor;
+    DataFrame<std::string> df = extractor.extractFromCsv("../generator/testData.csv");
+
+    // Escrever e ler de volta o mesmo DataFrame
+    std::string filePath = "test.cecol";
+    columnar::ColumnarWriter::write(filePath, df);
+    DataFrame<std::string> readBack = extractor.extractFromColumnar(filePath);
+
+    std::cout << "\nDataFrame lido do arquivo colunar:" << std::endl;
+    readBack.print();
+
+    // Nulos voltam como nulos (página de validade), inclusive em colunas numéricas
+    DataFrame<std::string> withNull({"id", "name"}, {Series<std::string>({"1", "2", "3"}), Series<std::string>({"a", "b", "c"})});
+    withNull["id"].setNull(1);
+    withNull["name"].setNull(2);
+    columnar::ColumnarWriter::write(filePath, withNull);
+    DataFrame<std::string> nullBack = extractor.extractFromColumnar(filePath);
+    std::cout << "\nNulos lidos de volta: " << nullBack["id"].isNull(1) << nullBack["name"].isNull(2)
+              << nullBack["id"].isNull(0) << ", id[2] = " << nullBack.getValue("id", 2) << std::endl;  // Esperado: 110, id[2] = 3
+
+    std::remove(filePath.c_str());
+    std::cout << "=== Fim do teste ===" << std::endl;
+}
+
 int main() {
     // Chama a função de teste
     testCsvExtractor();
     testSqliteExtractor();
+    testSqliteNumericPredicate();
+    testCsvStringColumns();
+    testCsvParallelLiteralQuote();
+    testJsonTrailingComma();
+    testColumnarRoundTrip();
     return 0;
 }